@@ -0,0 +1,241 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "s21_matrix_oop.h"
+#include "s21_solve.h"
+
+// Run with "make bench". Every benchmark reports bytes/s and, where the
+// operation does arithmetic, a FLOP/s counter; the Makefile also writes the
+// results to bench.json for comparison between releases.
+
+namespace {
+
+constexpr double kDoubleBytes = sizeof(double);
+
+// Well-conditioned test data: uniform noise plus a dominant diagonal.
+S21Matrix MakeMatrix(int rows, int cols, unsigned seed = 21) {
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+  S21Matrix matrix(rows, cols);
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) matrix(i, j) = distribution(generator);
+    if (i < cols) matrix(i, i) += cols;
+  }
+  return matrix;
+}
+
+void SetFlops(benchmark::State &state, double flops) {
+  state.counters["FLOPS"] = benchmark::Counter(
+      flops, benchmark::Counter::kIsIterationInvariantRate,
+      benchmark::Counter::kIs1000);
+}
+
+void SetBytes(benchmark::State &state, double bytes) {
+  state.SetBytesProcessed(static_cast<int64_t>(bytes * state.iterations()));
+}
+
+void BM_Construct(benchmark::State &state) {
+  int rows = state.range(0), cols = state.range(1);
+  for (auto _ : state) {
+    S21Matrix matrix(rows, cols);
+    benchmark::DoNotOptimize(matrix);
+  }
+  SetBytes(state, kDoubleBytes * rows * cols);
+}
+
+void BM_Copy(benchmark::State &state) {
+  int rows = state.range(0), cols = state.range(1);
+  S21Matrix source = MakeMatrix(rows, cols);
+  for (auto _ : state) {
+    S21Matrix copy(source);
+    benchmark::DoNotOptimize(copy);
+  }
+  SetBytes(state, 2 * kDoubleBytes * rows * cols);
+}
+
+void BM_Move(benchmark::State &state) {
+  int rows = state.range(0), cols = state.range(1);
+  S21Matrix source = MakeMatrix(rows, cols);
+  for (auto _ : state) {
+    S21Matrix moved(std::move(source));
+    source = std::move(moved);
+    benchmark::DoNotOptimize(source);
+  }
+}
+
+void BM_SumMatrix(benchmark::State &state) {
+  int rows = state.range(0), cols = state.range(1);
+  S21Matrix matrix = MakeMatrix(rows, cols), other = MakeMatrix(rows, cols, 7);
+  for (auto _ : state) {
+    matrix.SumMatrix(other);
+    benchmark::ClobberMemory();
+  }
+  SetFlops(state, 1.0 * rows * cols);
+  SetBytes(state, 3 * kDoubleBytes * rows * cols);
+}
+
+void BM_MulNumber(benchmark::State &state) {
+  int rows = state.range(0), cols = state.range(1);
+  S21Matrix matrix = MakeMatrix(rows, cols);
+  for (auto _ : state) {
+    matrix.MulNumber(1.0000001);
+    benchmark::ClobberMemory();
+  }
+  SetFlops(state, 1.0 * rows * cols);
+  SetBytes(state, 2 * kDoubleBytes * rows * cols);
+}
+
+void BM_MulMatrix(benchmark::State &state) {
+  int m = state.range(0), k = state.range(1), n = state.range(2);
+  S21Matrix lhs = MakeMatrix(m, k), rhs = MakeMatrix(k, n, 7);
+  for (auto _ : state) {
+    S21Matrix product(lhs);
+    product.MulMatrix(rhs);
+    benchmark::DoNotOptimize(product);
+  }
+  SetFlops(state, 2.0 * m * n * k);
+  SetBytes(state, kDoubleBytes * (1.0 * m * k + 1.0 * k * n + 1.0 * m * n));
+}
+
+// The same product in single precision: half the bytes, twice the lanes.
+void BM_MulMatrixFloat(benchmark::State &state) {
+  int m = state.range(0), k = state.range(1), n = state.range(2);
+  S21MatrixF lhs(MakeMatrix(m, k)), rhs(MakeMatrix(k, n, 7));
+  for (auto _ : state) {
+    S21MatrixF product(lhs);
+    product.MulMatrix(rhs);
+    benchmark::DoNotOptimize(product);
+  }
+  SetFlops(state, 2.0 * m * n * k);
+  SetBytes(state, sizeof(float) * (1.0 * m * k + 1.0 * k * n + 1.0 * m * n));
+}
+
+void BM_Transpose(benchmark::State &state) {
+  int rows = state.range(0), cols = state.range(1);
+  S21Matrix matrix = MakeMatrix(rows, cols);
+  for (auto _ : state) {
+    S21Matrix transposed = matrix.Transpose();
+    benchmark::DoNotOptimize(transposed);
+  }
+  SetBytes(state, 2 * kDoubleBytes * rows * cols);
+}
+
+void BM_Determinant(benchmark::State &state) {
+  int size = state.range(0);
+  S21Matrix matrix = MakeMatrix(size, size);
+  for (auto _ : state) benchmark::DoNotOptimize(matrix.Determinant());
+  SetFlops(state, 2.0 / 3.0 * size * size * size);
+  SetBytes(state, kDoubleBytes * size * size);
+}
+
+void BM_CalcComplements(benchmark::State &state) {
+  int size = state.range(0);
+  S21Matrix matrix = MakeMatrix(size, size);
+  for (auto _ : state) {
+    S21Matrix complements = matrix.CalcComplements();
+    benchmark::DoNotOptimize(complements);
+  }
+  SetFlops(state, 2.0 * size * size * size);
+  SetBytes(state, 2 * kDoubleBytes * size * size);
+}
+
+void BM_InverseMatrix(benchmark::State &state) {
+  int size = state.range(0);
+  S21Matrix matrix = MakeMatrix(size, size);
+  for (auto _ : state) {
+    S21Matrix inverse = matrix.InverseMatrix();
+    benchmark::DoNotOptimize(inverse);
+  }
+  SetFlops(state, 2.0 * size * size * size);
+  SetBytes(state, 2 * kDoubleBytes * size * size);
+}
+
+// Covariance-like input, which InverseMatrix inverts through Cholesky.
+void BM_InverseMatrixSpd(benchmark::State &state) {
+  int size = state.range(0);
+  S21Matrix noise = MakeMatrix(size, size), matrix(size, size);
+  matrix.Gemm(1.0, noise.View().Transpose(), noise, 0.0);
+  for (auto _ : state) {
+    S21Matrix inverse = matrix.InverseMatrix();
+    benchmark::DoNotOptimize(inverse);
+  }
+  SetFlops(state, 1.0 * size * size * size);
+  SetBytes(state, 2 * kDoubleBytes * size * size);
+}
+
+// Substitution only: the matrix is factored once outside the loop.
+void BM_LuSolve(benchmark::State &state) {
+  int size = state.range(0), rhs = state.range(1);
+  s21::LuFactorization lu(MakeMatrix(size, size));
+  S21Matrix b = MakeMatrix(size, rhs, 7), x(size, rhs);
+  for (auto _ : state) {
+    x = b;
+    lu.SolveInPlace(x.View());
+    benchmark::DoNotOptimize(x);
+  }
+  SetFlops(state, 2.0 * size * size * rhs);
+  SetBytes(state, kDoubleBytes * size * (size + 2 * rhs));
+}
+
+// Factorization and solve of a tall least-squares problem.
+void BM_LeastSquares(benchmark::State &state) {
+  int rows = state.range(0), cols = state.range(1);
+  S21Matrix a = MakeMatrix(rows, cols), b = MakeMatrix(rows, 1, 7);
+  for (auto _ : state) {
+    S21Matrix x = s21::Solve(a, b);
+    benchmark::DoNotOptimize(x);
+  }
+  SetFlops(state, 2.0 * cols * cols * (rows - cols / 3.0));
+  SetBytes(state, kDoubleBytes * rows * cols);
+}
+
+// Square sizes from 4 to 1024 plus a tall and a wide shape.
+void ElementWiseShapes(benchmark::internal::Benchmark *bench) {
+  for (int size = 4; size <= 1024; size *= 4) bench->Args({size, size});
+  bench->Args({4096, 16})->Args({16, 4096});
+}
+
+void ProductShapes(benchmark::internal::Benchmark *bench) {
+  for (int size = 4; size <= 1024; size *= 4) bench->Args({size, size, size});
+  bench->Args({1024, 64, 1024})->Args({64, 1024, 64});
+}
+
+}  // namespace
+
+BENCHMARK(BM_Construct)->Apply(ElementWiseShapes);
+BENCHMARK(BM_Copy)->Apply(ElementWiseShapes);
+BENCHMARK(BM_Move)->Apply(ElementWiseShapes);
+BENCHMARK(BM_SumMatrix)->Apply(ElementWiseShapes);
+BENCHMARK(BM_MulNumber)->Apply(ElementWiseShapes);
+BENCHMARK(BM_Transpose)->Apply(ElementWiseShapes);
+BENCHMARK(BM_MulMatrix)->Apply(ProductShapes)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_MulMatrixFloat)
+    ->Apply(ProductShapes)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Determinant)
+    ->RangeMultiplier(4)
+    ->Range(4, 1024)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_CalcComplements)
+    ->RangeMultiplier(4)
+    ->Range(4, 256)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_InverseMatrix)
+    ->RangeMultiplier(4)
+    ->Range(4, 1024)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_InverseMatrixSpd)
+    ->RangeMultiplier(4)
+    ->Range(4, 1024)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_LuSolve)
+    ->ArgsProduct({{64, 256, 1024}, {1, 16, 1024}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_LeastSquares)
+    ->Args({300, 100})
+    ->Args({2000, 200})
+    ->Args({4000, 400})
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,267 @@
+#ifndef SRC_S21_FIXED_MATRIX_H_
+#define SRC_S21_FIXED_MATRIX_H_
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "s21_matrix_oop.h"
+
+// Matrix with dimensions fixed at compile time and storage inside the
+// object, for small transforms where heap allocation and runtime bounds
+// checks dominate. Element access is unchecked; all loops have constant
+// trip counts and 2x2 to 4x4 determinants and inverses use closed forms.
+template <int Rows, int Cols>
+class S21FixedMatrix {
+  static_assert(Rows > 0 && Cols > 0, "Matrix dimensions must be positive.");
+
+ public:
+  static constexpr int kRows = Rows;
+  static constexpr int kCols = Cols;
+
+  constexpr S21FixedMatrix() noexcept : data_{} {}
+
+  explicit S21FixedMatrix(const S21Matrix &other) : data_{} {
+    if (other.GetRows() != Rows || other.GetCols() != Cols)
+      throw std::logic_error(
+          "Error: Matrices should be the same size of rows and columns.");
+    for (int i = 0; i < Rows; i++) {
+      for (int j = 0; j < Cols; j++) data_[i][j] = other(i, j);
+    }
+  }
+
+  explicit operator S21Matrix() const {
+    S21Matrix result(Rows, Cols);
+    for (int i = 0; i < Rows; i++) {
+      for (int j = 0; j < Cols; j++) result(i, j) = data_[i][j];
+    }
+    return result;
+  }
+
+  static constexpr int GetRows() noexcept { return Rows; }
+  static constexpr int GetCols() noexcept { return Cols; }
+
+  constexpr double &operator()(int row, int col) noexcept {
+    return data_[row][col];
+  }
+  constexpr const double &operator()(int row, int col) const noexcept {
+    return data_[row][col];
+  }
+
+  bool EqMatrix(const S21FixedMatrix &other) const noexcept {
+    return *this == other;
+  }
+  void SumMatrix(const S21FixedMatrix &other) noexcept { *this += other; }
+  void SubMatrix(const S21FixedMatrix &other) noexcept { *this -= other; }
+  void MulNumber(const double num) noexcept { *this *= num; }
+  void MulMatrix(const S21FixedMatrix<Cols, Cols> &other) noexcept {
+    *this = *this * other;
+  }
+
+  S21FixedMatrix<Cols, Rows> Transpose() const noexcept {
+    S21FixedMatrix<Cols, Rows> result;
+    for (int i = 0; i < Rows; i++) {
+      for (int j = 0; j < Cols; j++) result(j, i) = data_[i][j];
+    }
+    return result;
+  }
+
+  double Determinant() const noexcept {
+    static_assert(Rows == Cols, "Matrix should be square.");
+    const auto &a = data_;
+    if constexpr (Rows == 1) {
+      return a[0][0];
+    } else if constexpr (Rows == 2) {
+      return a[0][0] * a[1][1] - a[1][0] * a[0][1];
+    } else if constexpr (Rows == 3) {
+      return a[0][0] * (a[1][1] * a[2][2] - a[1][2] * a[2][1]) -
+             a[0][1] * (a[1][0] * a[2][2] - a[1][2] * a[2][0]) +
+             a[0][2] * (a[1][0] * a[2][1] - a[1][1] * a[2][0]);
+    } else if constexpr (Rows == 4) {
+      Pairs pairs = MinorPairs();
+      return pairs.s[0] * pairs.c[5] - pairs.s[1] * pairs.c[4] +
+             pairs.s[2] * pairs.c[3] + pairs.s[3] * pairs.c[2] -
+             pairs.s[4] * pairs.c[1] + pairs.s[5] * pairs.c[0];
+    } else {
+      S21FixedMatrix lu(*this);
+      double determinant = 1.0;
+      for (int k = 0; k < Rows; k++) {
+        int pivot = k;
+        for (int i = k + 1; i < Rows; i++) {
+          if (std::abs(lu(i, k)) > std::abs(lu(pivot, k))) pivot = i;
+        }
+        if (lu(pivot, k) == 0.0) return 0.0;
+        if (pivot != k) {
+          lu.SwapRows(k, pivot);
+          determinant = -determinant;
+        }
+        determinant *= lu(k, k);
+        for (int i = k + 1; i < Rows; i++) {
+          double factor = lu(i, k) / lu(k, k);
+          for (int j = k + 1; j < Cols; j++) lu(i, j) -= factor * lu(k, j);
+        }
+      }
+      return determinant;
+    }
+  }
+
+  S21FixedMatrix InverseMatrix() const {
+    static_assert(Rows == Cols, "Matrix should be square.");
+    const auto &a = data_;
+    S21FixedMatrix result;
+    if constexpr (Rows <= 4) {
+      double determinant = Determinant();
+      if (!(std::abs(determinant) > SingularTolerance()))
+        throw std::logic_error(
+            "Error: Matrix is not square or determinant is 0.");
+      double inverse = 1.0 / determinant;
+      if constexpr (Rows == 1) {
+        result(0, 0) = inverse;
+      } else if constexpr (Rows == 2) {
+        result(0, 0) = a[1][1] * inverse;
+        result(0, 1) = -a[0][1] * inverse;
+        result(1, 0) = -a[1][0] * inverse;
+        result(1, 1) = a[0][0] * inverse;
+      } else if constexpr (Rows == 3) {
+        for (int i = 0; i < 3; i++) {
+          int i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+          for (int j = 0; j < 3; j++) {
+            int j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+            result(j, i) =
+                (a[i1][j1] * a[i2][j2] - a[i1][j2] * a[i2][j1]) * inverse;
+          }
+        }
+      } else {
+        Pairs p = MinorPairs();
+        result(0, 0) = a[1][1] * p.c[5] - a[1][2] * p.c[4] + a[1][3] * p.c[3];
+        result(0, 1) = -a[0][1] * p.c[5] + a[0][2] * p.c[4] - a[0][3] * p.c[3];
+        result(0, 2) = a[3][1] * p.s[5] - a[3][2] * p.s[4] + a[3][3] * p.s[3];
+        result(0, 3) = -a[2][1] * p.s[5] + a[2][2] * p.s[4] - a[2][3] * p.s[3];
+        result(1, 0) = -a[1][0] * p.c[5] + a[1][2] * p.c[2] - a[1][3] * p.c[1];
+        result(1, 1) = a[0][0] * p.c[5] - a[0][2] * p.c[2] + a[0][3] * p.c[1];
+        result(1, 2) = -a[3][0] * p.s[5] + a[3][2] * p.s[2] - a[3][3] * p.s[1];
+        result(1, 3) = a[2][0] * p.s[5] - a[2][2] * p.s[2] + a[2][3] * p.s[1];
+        result(2, 0) = a[1][0] * p.c[4] - a[1][1] * p.c[2] + a[1][3] * p.c[0];
+        result(2, 1) = -a[0][0] * p.c[4] + a[0][1] * p.c[2] - a[0][3] * p.c[0];
+        result(2, 2) = a[3][0] * p.s[4] - a[3][1] * p.s[2] + a[3][3] * p.s[0];
+        result(2, 3) = -a[2][0] * p.s[4] + a[2][1] * p.s[2] - a[2][3] * p.s[0];
+        result(3, 0) = -a[1][0] * p.c[3] + a[1][1] * p.c[1] - a[1][2] * p.c[0];
+        result(3, 1) = a[0][0] * p.c[3] - a[0][1] * p.c[1] + a[0][2] * p.c[0];
+        result(3, 2) = -a[3][0] * p.s[3] + a[3][1] * p.s[1] - a[3][2] * p.s[0];
+        result(3, 3) = a[2][0] * p.s[3] - a[2][1] * p.s[1] + a[2][2] * p.s[0];
+        result *= inverse;
+      }
+    } else {
+      result = static_cast<S21FixedMatrix>(
+          static_cast<S21Matrix>(*this).InverseMatrix());
+    }
+    return result;
+  }
+
+  S21FixedMatrix &operator+=(const S21FixedMatrix &other) noexcept {
+    for (int i = 0; i < Rows; i++) {
+      for (int j = 0; j < Cols; j++) data_[i][j] += other.data_[i][j];
+    }
+    return *this;
+  }
+
+  S21FixedMatrix &operator-=(const S21FixedMatrix &other) noexcept {
+    for (int i = 0; i < Rows; i++) {
+      for (int j = 0; j < Cols; j++) data_[i][j] -= other.data_[i][j];
+    }
+    return *this;
+  }
+
+  S21FixedMatrix &operator*=(const double num) noexcept {
+    for (int i = 0; i < Rows; i++) {
+      for (int j = 0; j < Cols; j++) data_[i][j] *= num;
+    }
+    return *this;
+  }
+
+  S21FixedMatrix &operator*=(const S21FixedMatrix<Cols, Cols> &other) noexcept {
+    MulMatrix(other);
+    return *this;
+  }
+
+  S21FixedMatrix operator+(const S21FixedMatrix &other) const noexcept {
+    S21FixedMatrix result(*this);
+    return result += other;
+  }
+
+  S21FixedMatrix operator-(const S21FixedMatrix &other) const noexcept {
+    S21FixedMatrix result(*this);
+    return result -= other;
+  }
+
+  S21FixedMatrix operator*(const double num) const noexcept {
+    S21FixedMatrix result(*this);
+    return result *= num;
+  }
+
+  template <int OtherCols>
+  S21FixedMatrix<Rows, OtherCols> operator*(
+      const S21FixedMatrix<Cols, OtherCols> &other) const noexcept {
+    S21FixedMatrix<Rows, OtherCols> result;
+    for (int i = 0; i < Rows; i++) {
+      for (int k = 0; k < Cols; k++) {
+        for (int j = 0; j < OtherCols; j++)
+          result(i, j) += data_[i][k] * other(k, j);
+      }
+    }
+    return result;
+  }
+
+  bool operator==(const S21FixedMatrix &other) const noexcept {
+    for (int i = 0; i < Rows; i++) {
+      for (int j = 0; j < Cols; j++) {
+        if (std::abs(data_[i][j] - other.data_[i][j]) > s21::kEqualityTolerance)
+          return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  // The determinant below which S21Matrix::InverseMatrix would find a pivot
+  // lost in the rounding noise of the largest element: its pivot tolerance,
+  // n eps max|a|, times max|a|^(n-1) for the remaining pivots.
+  double SingularTolerance() const noexcept {
+    double max_abs = 0.0;
+    for (int i = 0; i < Rows; i++) {
+      for (int j = 0; j < Cols; j++)
+        max_abs = std::max(max_abs, std::abs(data_[i][j]));
+    }
+    double tolerance = Rows * std::numeric_limits<double>::epsilon();
+    for (int k = 0; k < Rows; k++) tolerance *= max_abs;
+    return tolerance;
+  }
+
+  // 2x2 determinants of the top two rows (s) and the bottom two rows (c)
+  // of a 4x4 matrix, over the column pairs 01, 02, 03, 12, 13, 23.
+  struct Pairs {
+    double s[6], c[6];
+  };
+
+  Pairs MinorPairs() const noexcept {
+    const auto &a = data_;
+    Pairs pairs{};
+    int index = 0;
+    for (int j = 0; j < 4; j++) {
+      for (int k = j + 1; k < 4; k++, index++) {
+        pairs.s[index] = a[0][j] * a[1][k] - a[0][k] * a[1][j];
+        pairs.c[index] = a[2][j] * a[3][k] - a[2][k] * a[3][j];
+      }
+    }
+    return pairs;
+  }
+
+  void SwapRows(int first, int second) noexcept {
+    for (int j = 0; j < Cols; j++) std::swap(data_[first][j], data_[second][j]);
+  }
+
+  double data_[Rows][Cols];
+};
+
+#endif  // SRC_S21_FIXED_MATRIX_H_
@@ -0,0 +1,154 @@
+#include "s21_gemm.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "s21_thread_pool.h"
+
+namespace s21 {
+
+namespace {
+
+// Register tile of the micro-kernel and cache block sizes: an MR x KC sliver
+// of A and a KC x NR sliver of B stay in L1, the packed MC x KC block of A in
+// L2 and the packed KC x NC panel of B in L3. A row of the tile is one cache
+// line whatever the element type, so floats get twice as many columns.
+constexpr int kMr = 4;
+template <typename T>
+constexpr int kNr = 64 / sizeof(T);
+constexpr int kKc = 256;
+constexpr int kMc = 128;
+constexpr int kNc = 2048;
+
+// Products below this many multiply-adds are not worth packing, and below
+// the second threshold not worth distributing over the thread pool.
+constexpr long kSmallGemm = 48L * 48L * 48L;
+constexpr long kParallelGemm = 128L * 128L * 128L;
+
+template <typename T>
+void NaiveGemm(int m, int n, int k, T alpha, const T *a, int a_rs, int a_cs,
+               const T *b, int b_rs, int b_cs, T *c, int c_rs, int c_cs) {
+  for (int i = 0; i < m; i++) {
+    T *c_row = c + i * c_rs;
+    for (int p = 0; p < k; p++) {
+      T a_ip = alpha * a[i * a_rs + p * a_cs];
+      const T *b_row = b + p * b_rs;
+      if (b_cs == 1 && c_cs == 1) {
+        for (int j = 0; j < n; j++) c_row[j] += a_ip * b_row[j];
+      } else {
+        for (int j = 0; j < n; j++) c_row[j * c_cs] += a_ip * b_row[j * b_cs];
+      }
+    }
+  }
+}
+
+// Packs alpha times an mc x kc block of A into row panels of height kMr,
+// column by column, padding the last panel with zeros.
+template <typename T>
+void PackA(int mc, int kc, T alpha, const T *a, int rs, int cs, T *buffer) {
+  for (int i = 0; i < mc; i += kMr) {
+    int rows = std::min(kMr, mc - i);
+    for (int p = 0; p < kc; p++) {
+      for (int r = 0; r < rows; r++)
+        *buffer++ = alpha * a[(i + r) * rs + p * cs];
+      for (int r = rows; r < kMr; r++) *buffer++ = T(0);
+    }
+  }
+}
+
+// Packs a kc x nc panel of B into column slivers of width kNr, row by row,
+// padding the last sliver with zeros.
+template <typename T>
+void PackB(int kc, int nc, const T *b, int rs, int cs, T *buffer) {
+  for (int j = 0; j < nc; j += kNr<T>) {
+    int cols = std::min(kNr<T>, nc - j);
+    for (int p = 0; p < kc; p++) {
+      const T *b_row = b + p * rs + j * cs;
+      for (int c = 0; c < cols; c++) *buffer++ = b_row[c * cs];
+      for (int c = cols; c < kNr<T>; c++) *buffer++ = T(0);
+    }
+  }
+}
+
+// Multiplies a packed kMr x kc sliver by a packed kc x kNr sliver and adds
+// the top-left m x n corner of the result to C.
+template <typename T>
+void MicroKernel(int kc, const T *a, const T *b, T *c, int rs, int cs, int m,
+                 int n) {
+  T acc[kMr][kNr<T>] = {};
+  for (int p = 0; p < kc; p++) {
+    for (int i = 0; i < kMr; i++) {
+      T a_ip = a[i];
+      for (int j = 0; j < kNr<T>; j++) acc[i][j] += a_ip * b[j];
+    }
+    a += kMr;
+    b += kNr<T>;
+  }
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < n; j++) c[i * rs + j * cs] += acc[i][j];
+  }
+}
+
+template <typename T>
+void MacroKernel(int mc, int nc, int kc, const T *packed_a, const T *packed_b,
+                 T *c, int rs, int cs) {
+  for (int j = 0; j < nc; j += kNr<T>) {
+    int n = std::min(kNr<T>, nc - j);
+    for (int i = 0; i < mc; i += kMr) {
+      int m = std::min(kMr, mc - i);
+      MicroKernel(kc, packed_a + i * kc, packed_b + j * kc,
+                  c + i * rs + j * cs, rs, cs, m, n);
+    }
+  }
+}
+
+}  // namespace
+
+template <typename T>
+void Gemm(int m, int n, int k, T alpha, const T *a, int a_rs, int a_cs,
+          const T *b, int b_rs, int b_cs, T *c, int c_rs, int c_cs) {
+  if (m <= 0 || n <= 0 || k <= 0 || alpha == T(0)) return;
+  long flops = static_cast<long>(m) * n * k;
+  if (flops < kSmallGemm) {
+    NaiveGemm(m, n, k, alpha, a, a_rs, a_cs, b, b_rs, b_cs, c, c_rs, c_cs);
+    return;
+  }
+  ThreadPool &pool = ThreadPool::Instance();
+  // Row blocks of C are the unit of parallel work, so with several threads
+  // they shrink until every thread gets at least one.
+  int mc = kMc;
+  if (flops >= kParallelGemm && !pool.Serial()) {
+    int threads = pool.GetThreadCount();
+    mc = std::min(kMc, ((m + threads - 1) / threads + kMr - 1) / kMr * kMr);
+  }
+  int blocks = (m + mc - 1) / mc;
+  thread_local std::vector<T> packed_b;
+  packed_b.resize(static_cast<std::size_t>(kNc + kNr<T>) * kKc);
+  for (int jc = 0; jc < n; jc += kNc) {
+    int nc = std::min(kNc, n - jc);
+    for (int pc = 0; pc < k; pc += kKc) {
+      int kc = std::min(kKc, k - pc);
+      PackB(kc, nc, b + pc * b_rs + jc * b_cs, b_rs, b_cs, packed_b.data());
+      const T *panel = packed_b.data();
+      pool.ParallelFor(blocks, [&](int block) {
+        thread_local std::vector<T> packed_a;
+        packed_a.resize(static_cast<std::size_t>(kMc + kMr) * kKc);
+        int ic = block * mc;
+        int rows = std::min(mc, m - ic);
+        PackA(rows, kc, alpha, a + ic * a_rs + pc * a_cs, a_rs, a_cs,
+              packed_a.data());
+        MacroKernel(rows, nc, kc, packed_a.data(), panel,
+                    c + ic * c_rs + jc * c_cs, c_rs, c_cs);
+      });
+    }
+  }
+}
+
+template void Gemm(int, int, int, float, const float *, int, int,
+                   const float *, int, int, float *, int, int);
+template void Gemm(int, int, int, double, const double *, int, int,
+                   const double *, int, int, double *, int, int);
+template void Gemm(int, int, int, long double, const long double *, int, int,
+                   const long double *, int, int, long double *, int, int);
+
+}  // namespace s21
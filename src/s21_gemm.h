@@ -0,0 +1,17 @@
+#ifndef SRC_S21_GEMM_H_
+#define SRC_S21_GEMM_H_
+
+namespace s21 {
+
+// Computes C += alpha * A * B where A is m x k, B is k x n and C is m x n.
+// Element
+// (i, j) of each operand lives at i * rs + j * cs of its buffer, so
+// row-major storage has cs == 1 and a transposed view swaps the two strides.
+// C must not overlap A or B. Instantiated for float, double and long double.
+template <typename T>
+void Gemm(int m, int n, int k, T alpha, const T *a, int a_rs, int a_cs,
+          const T *b, int b_rs, int b_cs, T *c, int c_rs, int c_cs);
+
+}  // namespace s21
+
+#endif  // SRC_S21_GEMM_H_
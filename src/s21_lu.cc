@@ -0,0 +1,409 @@
+#include "s21_lu.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "s21_simd.h"
+
+namespace s21 {
+
+namespace {
+
+// Substitution updates whole rows of B, one axpy over the nrhs right-hand
+// sides per element of the factors. Once B outgrows the cache it works on
+// blocks of kSolveBlock rows, so that a block of solved rows is reused by
+// the whole next block while still cached instead of streaming all solved
+// rows once per row.
+constexpr int kSolveBlock = 64;
+constexpr std::size_t kSolveCacheBytes = std::size_t(1) << 21;
+
+// Rows [first, last) of B -= rows [first, last) x columns [from, to) of the
+// factors times rows [from, to) of B.
+template <typename T>
+void UpdateRows(int first, int last, int from, int to, int nrhs, const T *lu,
+                int lda, T *b, int ldb) noexcept {
+  for (int i = first; i < last; i++) {
+    for (int k = from; k < to; k++)
+      simd::Axpy(nrhs, -lu[i * lda + k], b + k * ldb, b + i * ldb);
+  }
+}
+
+template <typename T>
+int SolveBlock(int n, int nrhs) noexcept {
+  std::size_t bytes = sizeof(T) * n * nrhs;
+  return bytes > kSolveCacheBytes ? kSolveBlock : n;
+}
+
+// Rows [first, last) of B -= columns [first, last) x rows [from, to) of the
+// factors, transposed, times rows [from, to) of B.
+template <typename T>
+void UpdateRowsTransposed(int first, int last, int from, int to, int nrhs,
+                          const T *l, int lda, T *b, int ldb) noexcept {
+  for (int k = first; k < last; k++) {
+    for (int i = from; i < to; i++)
+      simd::Axpy(nrhs, -l[i * lda + k], b + i * ldb, b + k * ldb);
+  }
+}
+
+// Forward substitution with the unit lower triangle.
+template <typename T>
+void LowerBlocks(int n, int nrhs, const T *lu, int lda, T *b,
+                 int ldb) noexcept {
+  int block = SolveBlock<T>(n, nrhs);
+  for (int first = 0; first < n; first += block) {
+    int last = std::min(n, first + block);
+    for (int from = 0; from < first; from += block)
+      UpdateRows(first, last, from, from + block, nrhs, lu, lda, b, ldb);
+    for (int i = first + 1; i < last; i++)
+      UpdateRows(i, i + 1, first, i, nrhs, lu, lda, b, ldb);
+  }
+}
+
+// Back substitution with the upper triangle.
+template <typename T>
+void UpperBlocks(int n, int nrhs, const T *lu, int lda, T *b,
+                 int ldb) noexcept {
+  int block = SolveBlock<T>(n, nrhs);
+  for (int last = n; last > 0; last -= block) {
+    int first = std::max(0, last - block);
+    for (int from = last; from < n; from += block) {
+      UpdateRows(first, last, from, std::min(n, from + block), nrhs, lu, lda,
+                 b, ldb);
+    }
+    for (int i = last - 1; i >= first; i--) {
+      UpdateRows(i, i + 1, i + 1, last, nrhs, lu, lda, b, ldb);
+      simd::Scale(nrhs, 1 / lu[i * lda + i], b + i * ldb);
+    }
+  }
+}
+
+// A single contiguous right-hand side: every element is a dot product with
+// a row of the factors.
+template <typename T>
+void LowerVector(int n, const T *lu, int lda, T *x) noexcept {
+  for (int i = 1; i < n; i++) x[i] -= simd::Dot(i, lu + i * lda, x);
+}
+
+template <typename T>
+void UpperVector(int n, const T *lu, int lda, T *x) noexcept {
+  for (int i = n - 1; i >= 0; i--) {
+    const T *row_i = lu + i * lda;
+    x[i] = (x[i] - simd::Dot(n - i - 1, row_i + i + 1, x + i + 1)) / row_i[i];
+  }
+}
+
+// L L^T X = B. Forward substitution is the one of LU scaled by the diagonal;
+// the transposed factor is applied right-looking, so that it too reads rows
+// of L.
+template <typename T>
+void CholeskyBlocks(int n, int nrhs, const T *l, int lda, T *b,
+                    int ldb) noexcept {
+  int block = SolveBlock<T>(n, nrhs);
+  for (int first = 0; first < n; first += block) {
+    int last = std::min(n, first + block);
+    for (int from = 0; from < first; from += block)
+      UpdateRows(first, last, from, from + block, nrhs, l, lda, b, ldb);
+    for (int i = first; i < last; i++) {
+      UpdateRows(i, i + 1, first, i, nrhs, l, lda, b, ldb);
+      simd::Scale(nrhs, 1 / l[i * lda + i], b + i * ldb);
+    }
+  }
+  for (int last = n; last > 0; last -= block) {
+    int first = std::max(0, last - block);
+    for (int i = last - 1; i >= first; i--) {
+      simd::Scale(nrhs, 1 / l[i * lda + i], b + i * ldb);
+      UpdateRowsTransposed(first, i, i, i + 1, nrhs, l, lda, b, ldb);
+    }
+    for (int above = 0; above < first; above += block) {
+      UpdateRowsTransposed(above, std::min(first, above + block), first, last,
+                           nrhs, l, lda, b, ldb);
+    }
+  }
+}
+
+template <typename T>
+void CholeskyVector(int n, const T *l, int lda, T *x) noexcept {
+  for (int i = 0; i < n; i++) {
+    const T *row_i = l + i * lda;
+    x[i] = (x[i] - simd::Dot(i, row_i, x)) / row_i[i];
+  }
+  for (int i = n - 1; i >= 0; i--) {
+    const T *row_i = l + i * lda;
+    x[i] /= row_i[i];
+    simd::Axpy(i, -x[i], row_i, x);
+  }
+}
+
+// Runs solve on a single right-hand side gathered into contiguous storage,
+// so that the dot products see unit strides.
+template <typename T, typename Solve>
+void SolveGathered(int n, T *b, int ldb, Solve solve) {
+  thread_local std::vector<T> x;
+  x.resize(n);
+  for (int i = 0; i < n; i++) x[i] = b[i * ldb];
+  solve(x.data());
+  for (int i = 0; i < n; i++) b[i * ldb] = x[i];
+}
+
+// Cholesky works on square tiles of this many rows and columns, which keeps
+// the rows of L feeding a tile's dot products in cache.
+constexpr int kCholeskyBlock = 128;
+
+}  // namespace
+
+template <typename T>
+int LuFactor(int n, T *a, int lda, int *pivots) {
+  int sign = 1;
+  for (int k = 0; k < n; k++) {
+    int pivot = k;
+    T pivot_abs = std::abs(a[k * lda + k]);
+    for (int i = k + 1; i < n; i++) {
+      T value = std::abs(a[i * lda + k]);
+      if (value > pivot_abs) {
+        pivot = i;
+        pivot_abs = value;
+      }
+    }
+    pivots[k] = pivot;
+    if (pivot_abs == T(0)) return 0;
+    T *row_k = a + k * lda;
+    if (pivot != k) {
+      std::swap_ranges(row_k, row_k + n, a + pivot * lda);
+      sign = -sign;
+    }
+    for (int i = k + 1; i < n; i++) {
+      T *row_i = a + i * lda;
+      T factor = row_i[k] / row_k[k];
+      row_i[k] = factor;
+      simd::Axpy(n - k - 1, -factor, row_k + k + 1, row_i + k + 1);
+    }
+  }
+  return sign;
+}
+
+template <typename T>
+void LuSolve(int n, int nrhs, const T *lu, int lda, const int *pivots, T *b,
+             int ldb) {
+  for (int k = 0; k < n; k++) {
+    if (pivots[k] != k)
+      std::swap_ranges(b + k * ldb, b + k * ldb + nrhs, b + pivots[k] * ldb);
+  }
+  if (nrhs != 1) {
+    LowerBlocks(n, nrhs, lu, lda, b, ldb);
+    UpperBlocks(n, nrhs, lu, lda, b, ldb);
+    return;
+  }
+  SolveGathered(n, b, ldb, [&](T *x) {
+    LowerVector(n, lu, lda, x);
+    UpperVector(n, lu, lda, x);
+  });
+}
+
+template <typename T>
+void UpperSolve(int n, int nrhs, const T *u, int ldu, T *b, int ldb) {
+  if (nrhs != 1) {
+    UpperBlocks(n, nrhs, u, ldu, b, ldb);
+    return;
+  }
+  SolveGathered(n, b, ldb, [&](T *x) { UpperVector(n, u, ldu, x); });
+}
+
+template <typename T>
+bool Symmetric(int n, const T *a, int lda, T tolerance) noexcept {
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < i; j++) {
+      if (!(std::abs(a[i * lda + j] - a[j * lda + i]) <= tolerance))
+        return false;
+    }
+  }
+  return true;
+}
+
+// Crout order: every element of L is a dot product of two rows of L, taken
+// tile by tile.
+template <typename T>
+bool CholeskyFactor(int n, T *a, int lda, T tolerance) noexcept {
+  for (int first = 0; first < n; first += kCholeskyBlock) {
+    int last = std::min(n, first + kCholeskyBlock);
+    for (int from = 0; from <= first; from += kCholeskyBlock) {
+      for (int i = first; i < last; i++) {
+        T *row_i = a + i * lda;
+        int to = std::min(from + kCholeskyBlock, i + 1);
+        for (int j = from; j < to; j++) {
+          const T *row_j = a + j * lda;
+          T sum = row_i[j] - simd::Dot(j, row_i, row_j);
+          if (j < i) {
+            row_i[j] = sum / row_j[j];
+          } else if (sum > tolerance) {
+            row_i[i] = std::sqrt(sum);
+          } else {
+            return false;
+          }
+        }
+      }
+    }
+  }
+  return true;
+}
+
+template <typename T>
+void CholeskySolve(int n, int nrhs, const T *l, int lda, T *b, int ldb) {
+  if (nrhs != 1) {
+    CholeskyBlocks(n, nrhs, l, lda, b, ldb);
+    return;
+  }
+  SolveGathered(n, b, ldb, [&](T *x) { CholeskyVector(n, l, lda, x); });
+}
+
+// Inverts L in place, then accumulates the lower triangle of
+// L^-T L^-1 = sum over k of (row k of L^-1)^T (row k of L^-1) and mirrors
+// it. Both passes are axpys over row prefixes, tiled like the factorization.
+template <typename T>
+void CholeskyInvert(int n, T *l, int lda, T *inverse, int ldi) {
+  for (int i = 0; i < n; i++) std::fill_n(inverse + i * ldi, n, T(0));
+  // Row i of L^-1 is -(row i of L below the diagonal) L^-1 / L(i, i),
+  // summed in row i of inverse until L(i, i) is no longer needed.
+  for (int first = 0; first < n; first += kCholeskyBlock) {
+    int last = std::min(n, first + kCholeskyBlock);
+    for (int from = 0; from < first; from += kCholeskyBlock) {
+      for (int i = first; i < last; i++) {
+        for (int k = from; k < from + kCholeskyBlock; k++)
+          simd::Axpy(k + 1, l[i * lda + k], l + k * lda, inverse + i * ldi);
+      }
+    }
+    for (int i = first; i < last; i++) {
+      T *row_i = l + i * lda, *sum = inverse + i * ldi;
+      for (int k = first; k < i; k++)
+        simd::Axpy(k + 1, row_i[k], l + k * lda, sum);
+      T diagonal = 1 / row_i[i];
+      for (int j = 0; j < i; j++) row_i[j] = -diagonal * sum[j];
+      row_i[i] = diagonal;
+      std::fill_n(sum, i, T(0));
+    }
+  }
+  for (int first = 0; first < n; first += kCholeskyBlock) {
+    int last = std::min(n, first + kCholeskyBlock);
+    for (int from = first; from < n; from += kCholeskyBlock) {
+      int to = std::min(n, from + kCholeskyBlock);
+      for (int i = first; i < last; i++) {
+        for (int k = std::max(i, from); k < to; k++)
+          simd::Axpy(i + 1, l[k * lda + i], l + k * lda, inverse + i * ldi);
+      }
+    }
+  }
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < i; j++) inverse[j * ldi + i] = inverse[i * ldi + j];
+  }
+}
+
+template <typename T>
+bool InvertInPlace(int n, T *a, int lda, int *pivots, T tolerance,
+                   T *determinant) {
+  T product = 1;
+  for (int k = 0; k < n; k++) {
+    int pivot = k;
+    T pivot_abs = std::abs(a[k * lda + k]);
+    for (int i = k + 1; i < n; i++) {
+      T value = std::abs(a[i * lda + k]);
+      if (value > pivot_abs) {
+        pivot = i;
+        pivot_abs = value;
+      }
+    }
+    pivots[k] = pivot;
+    if (!(pivot_abs > tolerance)) return false;
+    T *row_k = a + k * lda;
+    if (pivot != k) {
+      std::swap_ranges(row_k, row_k + n, a + pivot * lda);
+      product = -product;
+    }
+    product *= row_k[k];
+    T inverse = 1 / row_k[k];
+    row_k[k] = 1;
+    for (int j = 0; j < n; j++) row_k[j] *= inverse;
+    for (int i = 0; i < n; i++) {
+      if (i == k) continue;
+      T *row_i = a + i * lda;
+      T factor = row_i[k];
+      if (factor == T(0)) continue;
+      row_i[k] = 0;
+      for (int j = 0; j < n; j++) row_i[j] -= factor * row_k[j];
+    }
+  }
+  // Row exchanges of A become column exchanges of its inverse, undone in
+  // reverse order.
+  for (int k = n - 1; k >= 0; k--) {
+    if (pivots[k] == k) continue;
+    for (int i = 0; i < n; i++)
+      std::swap(a[i * lda + k], a[i * lda + pivots[k]]);
+  }
+  if (determinant) *determinant = product;
+  return true;
+}
+
+template <typename T>
+int RankInPlace(int n, T *a, int lda, T tolerance) {
+  for (int k = 0; k < n; k++) {
+    int pivot_row = k, pivot_col = k;
+    T pivot_abs = 0;
+    for (int i = k; i < n; i++) {
+      for (int j = k; j < n; j++) {
+        T value = std::abs(a[i * lda + j]);
+        if (value > pivot_abs) {
+          pivot_row = i;
+          pivot_col = j;
+          pivot_abs = value;
+        }
+      }
+    }
+    if (!(pivot_abs > tolerance)) return k;
+    T *row_k = a + k * lda;
+    std::swap_ranges(row_k, row_k + n, a + pivot_row * lda);
+    for (int i = 0; i < n; i++)
+      std::swap(a[i * lda + k], a[i * lda + pivot_col]);
+    for (int i = k + 1; i < n; i++) {
+      T *row_i = a + i * lda;
+      T factor = row_i[k] / row_k[k];
+      for (int j = k + 1; j < n; j++) row_i[j] -= factor * row_k[j];
+    }
+  }
+  return n;
+}
+
+template int LuFactor(int, float *, int, int *);
+template int LuFactor(int, double *, int, int *);
+template int LuFactor(int, long double *, int, int *);
+template void LuSolve(int, int, const float *, int, const int *, float *,
+                      int);
+template void LuSolve(int, int, const double *, int, const int *, double *,
+                      int);
+template void LuSolve(int, int, const long double *, int, const int *,
+                      long double *, int);
+template void UpperSolve(int, int, const float *, int, float *, int);
+template void UpperSolve(int, int, const double *, int, double *, int);
+template void UpperSolve(int, int, const long double *, int, long double *,
+                         int);
+template bool Symmetric(int, const float *, int, float) noexcept;
+template bool Symmetric(int, const double *, int, double) noexcept;
+template bool Symmetric(int, const long double *, int, long double) noexcept;
+template bool CholeskyFactor(int, float *, int, float) noexcept;
+template bool CholeskyFactor(int, double *, int, double) noexcept;
+template bool CholeskyFactor(int, long double *, int, long double) noexcept;
+template void CholeskySolve(int, int, const float *, int, float *, int);
+template void CholeskySolve(int, int, const double *, int, double *, int);
+template void CholeskySolve(int, int, const long double *, int, long double *,
+                            int);
+template void CholeskyInvert(int, float *, int, float *, int);
+template void CholeskyInvert(int, double *, int, double *, int);
+template void CholeskyInvert(int, long double *, int, long double *, int);
+template bool InvertInPlace(int, float *, int, int *, float, float *);
+template bool InvertInPlace(int, double *, int, int *, double, double *);
+template bool InvertInPlace(int, long double *, int, int *, long double,
+                            long double *);
+template int RankInPlace(int, float *, int, float);
+template int RankInPlace(int, double *, int, double);
+template int RankInPlace(int, long double *, int, long double);
+
+}  // namespace s21
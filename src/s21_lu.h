@@ -0,0 +1,65 @@
+#ifndef SRC_S21_LU_H_
+#define SRC_S21_LU_H_
+
+namespace s21 {
+
+// Kernels on row-major matrices with leading dimension lda, instantiated
+// for float, double and long double.
+
+// Factors the n x n row-major matrix A in place into P * A = L * U with
+// partial pivoting. L is unit lower triangular and shares the buffer with U;
+// pivots[i] is the row exchanged with row i at step i. Returns the sign of
+// the permutation, or 0 as soon as a column without a nonzero pivot is met.
+template <typename T>
+int LuFactor(int n, T *a, int lda, int *pivots);
+
+// Overwrites the n x nrhs row-major matrix B with the solution X of
+// A X = B, given the factors and pivots of A left by LuFactor. Large B is
+// substituted in blocks of rows; a single right-hand side by dot products.
+template <typename T>
+void LuSolve(int n, int nrhs, const T *lu, int lda, const int *pivots, T *b,
+             int ldb);
+
+// Overwrites the n x nrhs row-major matrix B with U^-1 B, where U is the
+// upper triangle of the n x n row-major matrix u.
+template <typename T>
+void UpperSolve(int n, int nrhs, const T *u, int ldu, T *b, int ldb);
+
+// Whether the n x n row-major matrix A is symmetric up to tolerance.
+template <typename T>
+bool Symmetric(int n, const T *a, int lda, T tolerance) noexcept;
+
+// Factors the symmetric n x n row-major matrix A in place into A = L * L^T,
+// reading and overwriting only the lower triangle. Returns false, leaving A
+// partially factored, as soon as a pivot does not exceed tolerance: A is
+// not positive definite, or too close to singular to tell.
+template <typename T>
+bool CholeskyFactor(int n, T *a, int lda, T tolerance) noexcept;
+
+// Overwrites the n x nrhs row-major matrix B with the solution X of
+// L L^T X = B, given the lower triangle L left by CholeskyFactor.
+template <typename T>
+void CholeskySolve(int n, int nrhs, const T *l, int lda, T *b, int ldb);
+
+// Writes the full inverse of L L^T to the n x n row-major matrix inverse,
+// given the lower triangle L left by CholeskyFactor, which is destroyed.
+template <typename T>
+void CholeskyInvert(int n, T *l, int lda, T *inverse, int ldi);
+
+// Replaces the n x n row-major matrix A with its inverse by Gauss-Jordan
+// elimination with partial pivoting, using pivots as scratch. Returns false,
+// leaving A partially reduced, if a pivot does not exceed tolerance in
+// absolute value. The determinant of A is stored if requested.
+template <typename T>
+bool InvertInPlace(int n, T *a, int lda, int *pivots, T tolerance,
+                   T *determinant = nullptr);
+
+// Returns the numerical rank of the n x n row-major matrix A: the number of
+// pivots above tolerance met by elimination with complete pivoting. A is
+// destroyed.
+template <typename T>
+int RankInPlace(int n, T *a, int lda, T tolerance);
+
+}  // namespace s21
+
+#endif  // SRC_S21_LU_H_
@@ -0,0 +1,344 @@
+#include "s21_matrix_batch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "s21_thread_pool.h"
+
+namespace {
+
+constexpr int kLanes = S21MatrixBatch::kLanes;
+
+// Batches with fewer multiply-adds than this run on the calling thread.
+constexpr double kParallelWork = 1 << 16;
+
+// One element of kLanes matrices. The operators loop over lanes with a
+// constant trip count, which the compiler turns into vector instructions.
+struct Lanes {
+  double v[kLanes];
+};
+
+Lanes Load(const double *data) noexcept {
+  Lanes result;
+  for (int l = 0; l < kLanes; l++) result.v[l] = data[l];
+  return result;
+}
+
+void Store(const Lanes &x, double *data) noexcept {
+  for (int l = 0; l < kLanes; l++) data[l] = x.v[l];
+}
+
+Lanes Broadcast(double value) noexcept {
+  Lanes result;
+  for (int l = 0; l < kLanes; l++) result.v[l] = value;
+  return result;
+}
+
+Lanes operator+(const Lanes &x, const Lanes &y) noexcept {
+  Lanes result;
+  for (int l = 0; l < kLanes; l++) result.v[l] = x.v[l] + y.v[l];
+  return result;
+}
+
+Lanes operator-(const Lanes &x, const Lanes &y) noexcept {
+  Lanes result;
+  for (int l = 0; l < kLanes; l++) result.v[l] = x.v[l] - y.v[l];
+  return result;
+}
+
+Lanes operator-(const Lanes &x) noexcept {
+  Lanes result;
+  for (int l = 0; l < kLanes; l++) result.v[l] = -x.v[l];
+  return result;
+}
+
+Lanes operator*(const Lanes &x, const Lanes &y) noexcept {
+  Lanes result;
+  for (int l = 0; l < kLanes; l++) result.v[l] = x.v[l] * y.v[l];
+  return result;
+}
+
+Lanes Reciprocal(const Lanes &x) noexcept {
+  Lanes result;
+  for (int l = 0; l < kLanes; l++) result.v[l] = 1.0 / x.v[l];
+  return result;
+}
+
+// Determinant of one block of N x N matrices; out receives the adjugate
+// (the inverse times the determinant) when it is given.
+template <int N>
+Lanes Adjugate(const Lanes (&a)[N][N], Lanes (*out)[N][N]) noexcept {
+  static_assert(N >= 1 && N <= 4, "Closed forms cover 1x1 to 4x4.");
+  if constexpr (N == 1) {
+    if (out) (*out)[0][0] = Broadcast(1.0);
+    return a[0][0];
+  } else if constexpr (N == 2) {
+    if (out) {
+      Lanes(&r)[2][2] = *out;
+      r[0][0] = a[1][1];
+      r[0][1] = -a[0][1];
+      r[1][0] = -a[1][0];
+      r[1][1] = a[0][0];
+    }
+    return a[0][0] * a[1][1] - a[1][0] * a[0][1];
+  } else if constexpr (N == 3) {
+    Lanes cofactor[3][3];
+    for (int i = 0; i < 3; i++) {
+      int i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+      for (int j = 0; j < 3; j++) {
+        int j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+        cofactor[i][j] = a[i1][j1] * a[i2][j2] - a[i1][j2] * a[i2][j1];
+        if (out) (*out)[j][i] = cofactor[i][j];
+      }
+    }
+    return a[0][0] * cofactor[0][0] + a[0][1] * cofactor[0][1] +
+           a[0][2] * cofactor[0][2];
+  } else {
+    // 2x2 determinants of the top two rows (s) and the bottom two rows (c)
+    // over the column pairs 01, 02, 03, 12, 13, 23.
+    Lanes s[6], c[6];
+    int index = 0;
+    for (int j = 0; j < 4; j++) {
+      for (int k = j + 1; k < 4; k++, index++) {
+        s[index] = a[0][j] * a[1][k] - a[0][k] * a[1][j];
+        c[index] = a[2][j] * a[3][k] - a[2][k] * a[3][j];
+      }
+    }
+    if (out) {
+      Lanes(&r)[4][4] = *out;
+      r[0][0] = a[1][1] * c[5] - a[1][2] * c[4] + a[1][3] * c[3];
+      r[0][1] = -a[0][1] * c[5] + a[0][2] * c[4] - a[0][3] * c[3];
+      r[0][2] = a[3][1] * s[5] - a[3][2] * s[4] + a[3][3] * s[3];
+      r[0][3] = -a[2][1] * s[5] + a[2][2] * s[4] - a[2][3] * s[3];
+      r[1][0] = -a[1][0] * c[5] + a[1][2] * c[2] - a[1][3] * c[1];
+      r[1][1] = a[0][0] * c[5] - a[0][2] * c[2] + a[0][3] * c[1];
+      r[1][2] = -a[3][0] * s[5] + a[3][2] * s[2] - a[3][3] * s[1];
+      r[1][3] = a[2][0] * s[5] - a[2][2] * s[2] + a[2][3] * s[1];
+      r[2][0] = a[1][0] * c[4] - a[1][1] * c[2] + a[1][3] * c[0];
+      r[2][1] = -a[0][0] * c[4] + a[0][1] * c[2] - a[0][3] * c[0];
+      r[2][2] = a[3][0] * s[4] - a[3][1] * s[2] + a[3][3] * s[0];
+      r[2][3] = -a[2][0] * s[4] + a[2][1] * s[2] - a[2][3] * s[0];
+      r[3][0] = -a[1][0] * c[3] + a[1][1] * c[1] - a[1][2] * c[0];
+      r[3][1] = a[0][0] * c[3] - a[0][1] * c[1] + a[0][2] * c[0];
+      r[3][2] = -a[3][0] * s[3] + a[3][1] * s[1] - a[3][2] * s[0];
+      r[3][3] = a[2][0] * s[3] - a[2][1] * s[1] + a[2][2] * s[0];
+    }
+    return s[0] * c[5] - s[1] * c[4] + s[2] * c[3] + s[3] * c[2] -
+           s[4] * c[1] + s[5] * c[0];
+  }
+}
+
+template <int N>
+void LoadBlock(const S21MatrixBatch &batch, int block,
+               Lanes (&a)[N][N]) noexcept {
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j < N; j++)
+      a[i][j] = Load(batch.Plane(i, j) + block * kLanes);
+  }
+}
+
+template <int N>
+void DeterminantBlock(const S21MatrixBatch &batch, int block,
+                      double *result) noexcept {
+  Lanes a[N][N];
+  LoadBlock<N>(batch, block, a);
+  Store(Adjugate<N>(a, nullptr), result + block * kLanes);
+}
+
+// Stores the inverses of the block and returns false if one of its first
+// lanes matrices is singular. As in S21Matrix::InverseMatrix, that means a
+// pivot within n eps max|a| of zero; times max|a|^(n-1) for the other pivots
+// it bounds the determinant.
+template <int N>
+bool InverseBlock(const S21MatrixBatch &batch, int block, int lanes,
+                  S21MatrixBatch &result) noexcept {
+  Lanes a[N][N], adjugate[N][N];
+  LoadBlock<N>(batch, block, a);
+  Lanes determinant = Adjugate<N>(a, &adjugate);
+  Lanes inverse = Reciprocal(determinant);
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j < N; j++)
+      Store(adjugate[i][j] * inverse, result.Plane(i, j) + block * kLanes);
+  }
+  Lanes max_abs = Broadcast(0.0);
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j < N; j++) {
+      for (int l = 0; l < kLanes; l++)
+        max_abs.v[l] = std::max(max_abs.v[l], std::abs(a[i][j].v[l]));
+    }
+  }
+  Lanes tolerance = Broadcast(N * std::numeric_limits<double>::epsilon());
+  for (int k = 0; k < N; k++) tolerance = tolerance * max_abs;
+  for (int l = 0; l < lanes; l++) {
+    if (!(std::abs(determinant.v[l]) > tolerance.v[l])) return false;
+  }
+  return true;
+}
+
+// Calls task(block) for every block, over the thread pool when the whole
+// batch costs more than kParallelWork.
+template <typename Task>
+void ForBlocks(int blocks, double work_per_block, const Task &task) {
+  s21::ThreadPool &pool = s21::ThreadPool::Instance();
+  int pieces = std::min(blocks, pool.GetThreadCount() * 4);
+  if (blocks * work_per_block < kParallelWork || pieces <= 1) {
+    for (int block = 0; block < blocks; block++) task(block);
+    return;
+  }
+  pool.ParallelFor(pieces, [&task, blocks, pieces](int piece) {
+    int end = static_cast<long>(blocks) * (piece + 1) / pieces;
+    for (int block = static_cast<long>(blocks) * piece / pieces; block < end;
+         block++)
+      task(block);
+  });
+}
+
+}  // namespace
+
+S21MatrixBatch::S21MatrixBatch() noexcept
+    : count_(0), rows_(0), cols_(0), plane_stride_(0) {}
+
+S21MatrixBatch::S21MatrixBatch(int count, int rows, int cols)
+    : count_(count), rows_(rows), cols_(cols) {
+  if (count <= 0 || rows <= 0 || cols <= 0)
+    throw std::invalid_argument("Invalid parameter for count, rows or cols.");
+  plane_stride_ =
+      (static_cast<std::size_t>(count) + kLanes - 1) / kLanes * kLanes;
+  data_.assign(plane_stride_ * rows * cols, 0.0);
+}
+
+double &S21MatrixBatch::operator()(int index, int row, int col) {
+  CheckIndex(index, row, col);
+  return Plane(row, col)[index];
+}
+
+const double &S21MatrixBatch::operator()(int index, int row, int col) const {
+  CheckIndex(index, row, col);
+  return Plane(row, col)[index];
+}
+
+double *S21MatrixBatch::Plane(int row, int col) noexcept {
+  return data_.data() + (row * cols_ + col) * plane_stride_;
+}
+
+const double *S21MatrixBatch::Plane(int row, int col) const noexcept {
+  return data_.data() + (row * cols_ + col) * plane_stride_;
+}
+
+S21Matrix S21MatrixBatch::Get(int index) const {
+  CheckIndex(index, 0, 0);
+  S21Matrix result(rows_, cols_);
+  for (int i = 0; i < rows_; i++) {
+    for (int j = 0; j < cols_; j++) result(i, j) = Plane(i, j)[index];
+  }
+  return result;
+}
+
+void S21MatrixBatch::Set(int index, const S21Matrix &matrix) {
+  CheckIndex(index, 0, 0);
+  if (matrix.GetRows() != rows_ || matrix.GetCols() != cols_)
+    throw std::logic_error(
+        "Error: Matrices should be the same size of rows and columns.");
+  for (int i = 0; i < rows_; i++) {
+    for (int j = 0; j < cols_; j++) Plane(i, j)[index] = matrix(i, j);
+  }
+}
+
+void S21MatrixBatch::MulMatrix(const S21MatrixBatch &other) {
+  if (count_ != other.count_)
+    throw std::logic_error("Error: Batches should hold as many matrices.");
+  if (cols_ != other.rows_)
+    throw std::logic_error(
+        "Error: Rows of first matrix should be equal with columns of second "
+        "matrix.");
+  S21MatrixBatch result(count_, rows_, other.cols_);
+  int inner = cols_;
+  ForBlocks(Blocks(),
+            static_cast<double>(rows_) * inner * other.cols_ * kLanes,
+            [this, &other, &result, inner](int block) {
+              std::size_t offset = block * kLanes;
+              for (int i = 0; i < result.rows_; i++) {
+                for (int j = 0; j < result.cols_; j++) {
+                  Lanes sum = Load(Plane(i, 0) + offset) *
+                              Load(other.Plane(0, j) + offset);
+                  for (int k = 1; k < inner; k++)
+                    sum = sum + Load(Plane(i, k) + offset) *
+                                    Load(other.Plane(k, j) + offset);
+                  Store(sum, result.Plane(i, j) + offset);
+                }
+              }
+            });
+  *this = std::move(result);
+}
+
+S21MatrixBatch S21MatrixBatch::Transpose() const {
+  if (!count_) return S21MatrixBatch();
+  S21MatrixBatch result(count_, cols_, rows_);
+  for (int i = 0; i < rows_; i++) {
+    for (int j = 0; j < cols_; j++)
+      std::copy(Plane(i, j), Plane(i, j) + plane_stride_, result.Plane(j, i));
+  }
+  return result;
+}
+
+std::vector<double> S21MatrixBatch::Determinant() const {
+  if (rows_ != cols_)
+    throw std::length_error("Error: Matrix should be square.");
+  std::vector<double> result(plane_stride_);
+  if (rows_ > 4) {
+    for (int index = 0; index < count_; index++)
+      result[index] = Get(index).Determinant();
+  } else {
+    double work = static_cast<double>(rows_) * rows_ * rows_ * kLanes;
+    ForBlocks(Blocks(), work, [this, &result](int block) {
+      if (rows_ == 1) {
+        DeterminantBlock<1>(*this, block, result.data());
+      } else if (rows_ == 2) {
+        DeterminantBlock<2>(*this, block, result.data());
+      } else if (rows_ == 3) {
+        DeterminantBlock<3>(*this, block, result.data());
+      } else {
+        DeterminantBlock<4>(*this, block, result.data());
+      }
+    });
+  }
+  result.resize(count_);
+  return result;
+}
+
+S21MatrixBatch S21MatrixBatch::InverseMatrix() const {
+  if (rows_ != cols_ || !count_)
+    throw std::logic_error("Error: Matrix is not square or determinant is 0.");
+  S21MatrixBatch result(count_, rows_, cols_);
+  if (rows_ > 4) {
+    for (int index = 0; index < count_; index++)
+      result.Set(index, Get(index).InverseMatrix());
+    return result;
+  }
+  double work = static_cast<double>(rows_) * rows_ * rows_ * kLanes;
+  ForBlocks(Blocks(), work, [this, &result](int block) {
+    int lanes = std::min(kLanes, count_ - block * kLanes);
+    bool regular;
+    if (rows_ == 1) {
+      regular = InverseBlock<1>(*this, block, lanes, result);
+    } else if (rows_ == 2) {
+      regular = InverseBlock<2>(*this, block, lanes, result);
+    } else if (rows_ == 3) {
+      regular = InverseBlock<3>(*this, block, lanes, result);
+    } else {
+      regular = InverseBlock<4>(*this, block, lanes, result);
+    }
+    if (!regular)
+      throw std::logic_error(
+          "Error: Matrix is not square or determinant is 0.");
+  });
+  return result;
+}
+
+void S21MatrixBatch::CheckIndex(int index, int row, int col) const {
+  if (index < 0 || index >= count_ || row < 0 || row >= rows_ || col < 0 ||
+      col >= cols_)
+    throw std::range_error("Error: You try to put value out of matrix.");
+}
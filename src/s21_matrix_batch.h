@@ -0,0 +1,54 @@
+#ifndef SRC_S21_MATRIX_BATCH_H_
+#define SRC_S21_MATRIX_BATCH_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Many matrices of one shape stored structure-of-arrays: element (i, j) of
+// every matrix forms one contiguous plane, so batch operations run the same
+// arithmetic on consecutive lanes and vectorize across matrices instead of
+// within one. Meant for large numbers of small matrices; 1x1 to 4x4
+// determinants and inverses use closed forms, larger ones fall back to
+// S21Matrix one matrix at a time. Large batches are split across the
+// thread pool.
+class S21MatrixBatch {
+ public:
+  // Planes are padded to whole blocks of kLanes matrices; the kernels work
+  // a block at a time.
+  static constexpr int kLanes = 8;
+
+  S21MatrixBatch() noexcept;
+  S21MatrixBatch(int count, int rows, int cols);
+
+  int GetCount() const noexcept { return count_; }
+  int GetRows() const noexcept { return rows_; }
+  int GetCols() const noexcept { return cols_; }
+
+  double &operator()(int index, int row, int col);
+  const double &operator()(int index, int row, int col) const;
+  // Element (row, col) of all GetCount() matrices, unchecked.
+  double *Plane(int row, int col) noexcept;
+  const double *Plane(int row, int col) const noexcept;
+
+  S21Matrix Get(int index) const;
+  void Set(int index, const S21Matrix &matrix);
+
+  // Pairwise: matrix i of the batch times matrix i of other.
+  void MulMatrix(const S21MatrixBatch &other);
+  S21MatrixBatch Transpose() const;
+  std::vector<double> Determinant() const;
+  // Throws if any matrix of the batch is singular.
+  S21MatrixBatch InverseMatrix() const;
+
+ private:
+  void CheckIndex(int index, int row, int col) const;
+  int Blocks() const noexcept { return plane_stride_ / kLanes; }
+
+  int count_, rows_, cols_;
+  std::size_t plane_stride_;
+  std::vector<double> data_;
+};
+
+#endif  // SRC_S21_MATRIX_BATCH_H_
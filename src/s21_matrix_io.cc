@@ -0,0 +1,459 @@
+#include "s21_matrix_io.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <charconv>
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+#include "s21_thread_pool.h"
+
+namespace s21 {
+
+namespace {
+
+constexpr char kMagic[8] = {'S', '2', '1', 'M', 'A', 'T', 'R', 'X'};
+
+template <typename T>
+constexpr std::uint32_t kDtype = 0;
+template <>
+constexpr std::uint32_t kDtype<float> = kMatrixFileFloat32;
+template <>
+constexpr std::uint32_t kDtype<double> = kMatrixFileFloat64;
+template <>
+constexpr std::uint32_t kDtype<long double> = kMatrixFileLongDouble;
+
+// Bytes per element of a file element type, 0 for unknown ones.
+std::size_t ElementSize(std::uint32_t dtype) noexcept {
+  switch (dtype) {
+    case kMatrixFileFloat32:
+      return sizeof(float);
+    case kMatrixFileFloat64:
+      return sizeof(double);
+    case kMatrixFileLongDouble:
+      return sizeof(long double);
+    default:
+      return 0;
+  }
+}
+
+std::size_t ElementCount(const MatrixFileHeader &header) noexcept {
+  return static_cast<std::size_t>(header.rows) *
+         static_cast<std::size_t>(header.stride);
+}
+
+std::size_t BlockBytes(const MatrixFileHeader &header) noexcept {
+  return ElementCount(header) * ElementSize(header.dtype);
+}
+
+// Throws unless header describes a matrix that fits in a file of file_bytes.
+void CheckHeader(const MatrixFileHeader &header, std::uint64_t file_bytes) {
+  if (std::memcmp(header.magic, kMagic, sizeof kMagic) != 0)
+    throw std::runtime_error("Error: Not a matrix file.");
+  if (header.version != kMatrixFileVersion || !ElementSize(header.dtype))
+    throw std::runtime_error("Error: Unsupported matrix file format.");
+  if (header.rows < 0 || header.cols < 0 || header.rows > INT_MAX ||
+      header.cols > INT_MAX || header.stride < header.cols ||
+      header.stride > INT_MAX || (header.rows == 0) != (header.cols == 0) ||
+      header.data_offset < sizeof header ||
+      header.data_offset % MatrixPool::kAlignment != 0)
+    throw std::runtime_error("Error: Corrupt matrix file header.");
+  if (header.data_offset > file_bytes ||
+      ElementCount(header) >
+          (file_bytes - header.data_offset) / ElementSize(header.dtype))
+    throw std::runtime_error("Error: Matrix file is truncated.");
+}
+
+template <typename T>
+void CheckElementType(const MatrixFileHeader &header) {
+  if (header.dtype != kDtype<T>)
+    throw std::runtime_error("Error: Matrix file holds another element type.");
+}
+
+// Text is parsed in pieces of at least this many bytes, and written in
+// pieces of about this size.
+constexpr std::size_t kTextChunkBytes = std::size_t{1} << 20;
+
+struct TextChunk {
+  const char *begin, *end;
+  int first_row, rows;
+};
+
+bool IsBlank(char c) noexcept { return c == ' ' || c == '\t' || c == '\r'; }
+
+const char *LineEnd(const char *begin, const char *end) noexcept {
+  const void *newline = std::memchr(begin, '\n', end - begin);
+  return newline ? static_cast<const char *>(newline) : end;
+}
+
+bool BlankLine(const char *begin, const char *end) noexcept {
+  return std::all_of(begin, end, IsBlank);
+}
+
+// Start of the line after the one ending at stop, or end after the last
+// line, which need not end in a newline.
+const char *NextLine(const char *stop, const char *end) noexcept {
+  return stop == end ? end : stop + 1;
+}
+
+// The separators ParseRow accepts between numbers.
+bool IsDelimiter(char c) noexcept { return IsBlank(c) || c == ',' || c == ';'; }
+
+// Parses the numbers of one line, storing at most capacity of them into
+// row, and returns how many there are.
+template <typename T>
+int ParseRow(const char *begin, const char *end, T *row, int capacity) {
+  int count = 0;
+  const char *p = begin;
+  while (true) {
+    while (p != end && IsBlank(*p)) p++;
+    if (p == end) break;
+    // from_chars takes no '+', so skip one, but not one before another sign.
+    if (*p == '+' && (p + 1 == end || (p[1] != '-' && p[1] != '+'))) p++;
+    T value;
+    auto [next, error] = std::from_chars(p, end, value);
+    if (error != std::errc())
+      throw std::runtime_error("Error: Malformed number in matrix text.");
+    if (count < capacity) row[count] = value;
+    count++;
+    p = next;
+    if (p != end && !IsDelimiter(*p))
+      throw std::runtime_error("Error: Malformed number in matrix text.");
+    while (p != end && IsBlank(*p)) p++;
+    if (p != end && (*p == ',' || *p == ';')) p++;
+  }
+  return count;
+}
+
+// Cuts text into about count pieces that end on line boundaries.
+std::vector<TextChunk> SplitLines(const char *begin, const char *end,
+                                  int count) {
+  std::vector<TextChunk> chunks;
+  std::size_t step = (end - begin) / count + 1;
+  for (const char *p = begin; p != end;) {
+    const char *stop = end - p > static_cast<std::ptrdiff_t>(step)
+                           ? LineEnd(p + step, end)
+                           : end;
+    if (stop != end) stop++;
+    chunks.push_back({p, stop, 0, 0});
+    p = stop;
+  }
+  return chunks;
+}
+
+int CountRows(const char *begin, const char *end) noexcept {
+  int rows = 0;
+  for (const char *p = begin; p != end;) {
+    const char *stop = LineEnd(p, end);
+    if (!BlankLine(p, stop)) rows++;
+    p = NextLine(stop, end);
+  }
+  return rows;
+}
+
+// Read-only mapping of a whole text file; empty files map to nothing.
+class TextFile {
+ public:
+  explicit TextFile(const std::string &path) : data_(nullptr), bytes_(0) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("Error: Cannot open matrix file.");
+    struct stat status;
+    if (fstat(fd, &status) != 0) {
+      close(fd);
+      throw std::runtime_error("Error: Cannot open matrix file.");
+    }
+    bytes_ = status.st_size;
+    if (bytes_) {
+      data_ = mmap(nullptr, bytes_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data_ == MAP_FAILED) data_ = nullptr;
+    }
+    close(fd);
+    if (bytes_ && !data_)
+      throw std::runtime_error("Error: Cannot map matrix file.");
+    if (data_) madvise(data_, bytes_, MADV_SEQUENTIAL);
+  }
+  ~TextFile() {
+    if (data_) munmap(data_, bytes_);
+  }
+  TextFile(const TextFile &) = delete;
+  TextFile &operator=(const TextFile &) = delete;
+
+  std::string_view Text() const noexcept {
+    return {static_cast<const char *>(data_), bytes_};
+  }
+
+ private:
+  void *data_;
+  std::size_t bytes_;
+};
+
+}  // namespace
+
+std::uint64_t MatrixChecksum(const void *data, std::size_t bytes,
+                             std::uint64_t hash) noexcept {
+  const char *p = static_cast<const char *>(data);
+  for (std::size_t i = 0; i < bytes; i += sizeof(std::uint64_t)) {
+    std::uint64_t word = 0;
+    std::memcpy(&word, p + i, std::min(sizeof word, bytes - i));
+    hash = (hash ^ word) * 1099511628211ULL;
+  }
+  return hash;
+}
+
+FileMapping::FileMapping(const std::string &path, MapMode mode)
+    : base_(nullptr), bytes_(0), mode_(mode) {
+  int fd = open(path.c_str(), mode == MapMode::kShared ? O_RDWR : O_RDONLY);
+  if (fd < 0) throw std::runtime_error("Error: Cannot open matrix file.");
+  struct stat status;
+  if (fstat(fd, &status) != 0 ||
+      static_cast<std::size_t>(status.st_size) < sizeof(MatrixFileHeader)) {
+    close(fd);
+    throw std::runtime_error("Error: Not a matrix file.");
+  }
+  bytes_ = status.st_size;
+  base_ = mmap(nullptr, bytes_, PROT_READ | PROT_WRITE,
+               mode == MapMode::kShared ? MAP_SHARED : MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (base_ == MAP_FAILED)
+    throw std::runtime_error("Error: Cannot map matrix file.");
+  try {
+    CheckHeader(Header(), bytes_);
+  } catch (...) {
+    munmap(base_, bytes_);
+    throw;
+  }
+}
+
+FileMapping::~FileMapping() {
+  if (mode_ == MapMode::kShared) {
+    MatrixFileHeader &header = *static_cast<MatrixFileHeader *>(base_);
+    header.checksum = MatrixChecksum(Data(), BlockBytes(header));
+  }
+  munmap(base_, bytes_);
+}
+
+const MatrixFileHeader &FileMapping::Header() const noexcept {
+  return *static_cast<const MatrixFileHeader *>(base_);
+}
+
+void *FileMapping::Data() const noexcept {
+  return static_cast<char *>(base_) + Header().data_offset;
+}
+
+}  // namespace s21
+
+template <typename T>
+void S21BasicMatrix<T>::Save(const std::string &path) const {
+  s21::MatrixFileHeader header = {};
+  std::memcpy(header.magic, s21::kMagic, sizeof header.magic);
+  header.version = s21::kMatrixFileVersion;
+  header.dtype = s21::kDtype<T>;
+  header.rows = rows_;
+  header.cols = cols_;
+  header.stride = stride_;
+  header.data_offset = s21::kMatrixFileDataOffset;
+  std::size_t bytes = static_cast<std::size_t>(rows_) * stride_ * sizeof(T);
+  header.checksum = s21::MatrixChecksum(matrix_, bytes);
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file) throw std::runtime_error("Error: Cannot open matrix file.");
+  std::vector<char> padding(header.data_offset - sizeof header);
+  file.write(reinterpret_cast<const char *>(&header), sizeof header);
+  file.write(padding.data(), padding.size());
+  if (bytes) file.write(reinterpret_cast<const char *>(matrix_), bytes);
+  if (!file.flush())
+    throw std::runtime_error("Error: Cannot write matrix file.");
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Load(const std::string &path) {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file) throw std::runtime_error("Error: Cannot open matrix file.");
+  std::uint64_t file_bytes = file.tellg();
+  s21::MatrixFileHeader header;
+  file.seekg(0);
+  if (!file.read(reinterpret_cast<char *>(&header), sizeof header))
+    throw std::runtime_error("Error: Not a matrix file.");
+  s21::CheckHeader(header, file_bytes);
+  s21::CheckElementType<T>(header);
+
+  S21BasicMatrix result;
+  if (header.rows == 0) return result;
+  result.rows_ = header.rows;
+  result.cols_ = header.cols;
+  result.CreateMatrix();
+  std::size_t bytes = s21::BlockBytes(header);
+  std::uint64_t checksum;
+  file.seekg(header.data_offset);
+  if (header.stride == result.stride_) {
+    file.read(reinterpret_cast<char *>(result.matrix_), bytes);
+    checksum = s21::MatrixChecksum(result.matrix_, bytes);
+  } else {
+    // Written with another row alignment: repack row by row.
+    std::vector<T> row(header.stride);
+    checksum = s21::kMatrixChecksumSeed;
+    for (int i = 0; i < result.rows_ && file; i++) {
+      file.read(reinterpret_cast<char *>(row.data()), row.size() * sizeof(T));
+      checksum =
+          s21::MatrixChecksum(row.data(), row.size() * sizeof(T), checksum);
+      std::copy(row.begin(), row.begin() + result.cols_, result.Row(i));
+    }
+  }
+  if (!file) throw std::runtime_error("Error: Matrix file is truncated.");
+  if (checksum != header.checksum)
+    throw std::runtime_error("Error: Matrix file checksum mismatch.");
+  return result;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Map(const std::string &path,
+                                         s21::MapMode mode) {
+  auto mapping = std::make_unique<s21::FileMapping>(path, mode);
+  const s21::MatrixFileHeader &header = mapping->Header();
+  s21::CheckElementType<T>(header);
+  S21BasicMatrix result;
+  if (header.rows == 0) return result;
+  result.rows_ = header.rows;
+  result.cols_ = header.cols;
+  result.stride_ = header.stride;
+  result.matrix_ = static_cast<T *>(mapping->Data());
+  result.mapping_ = mapping.release();
+  return result;
+}
+
+template <typename T>
+bool S21BasicMatrix<T>::Mapped() const noexcept {
+  return mapping_ != nullptr;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::ParseText(std::string_view text) {
+  const char *begin = text.data(), *end = begin + text.size();
+  const char *first = begin;
+  while (first != end) {
+    const char *stop = s21::LineEnd(first, end);
+    if (!s21::BlankLine(first, stop)) break;
+    first = s21::NextLine(stop, end);
+  }
+  if (first == end) return S21BasicMatrix();
+  int cols =
+      s21::ParseRow<T>(first, s21::LineEnd(first, end), nullptr, 0);
+
+  s21::ThreadPool &pool = s21::ThreadPool::Instance();
+  int pieces = std::min<std::size_t>(pool.GetThreadCount() * 4,
+                                     text.size() / s21::kTextChunkBytes + 1);
+  std::vector<s21::TextChunk> chunks = s21::SplitLines(first, end, pieces);
+  int count = chunks.size();
+  pool.ParallelFor(count, [&chunks](int c) {
+    chunks[c].rows = s21::CountRows(chunks[c].begin, chunks[c].end);
+  });
+  int rows = 0;
+  for (s21::TextChunk &chunk : chunks) {
+    chunk.first_row = rows;
+    rows += chunk.rows;
+  }
+
+  S21BasicMatrix result(rows, cols);
+  pool.ParallelFor(count, [&chunks, &result, cols](int c) {
+    int row = chunks[c].first_row;
+    for (const char *p = chunks[c].begin; p != chunks[c].end;) {
+      const char *stop = s21::LineEnd(p, chunks[c].end);
+      if (!s21::BlankLine(p, stop)) {
+        if (s21::ParseRow(p, stop, result.Row(row++), cols) != cols)
+          throw std::runtime_error(
+              "Error: Rows of matrix text differ in length.");
+      }
+      p = s21::NextLine(stop, chunks[c].end);
+    }
+  });
+  return result;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::LoadText(const std::string &path) {
+  s21::TextFile file(path);
+  return ParseText(file.Text());
+}
+
+template <typename T>
+void S21BasicMatrix<T>::SaveText(const std::string &path,
+                                 char delimiter) const {
+  if (!s21::IsDelimiter(delimiter))
+    throw std::invalid_argument(
+        "Error: Matrix text delimiter should be a blank, comma or semicolon.");
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file) throw std::runtime_error("Error: Cannot open matrix file.");
+  // Bound on the shortest round-trip form: sign, digits, point and exponent.
+  constexpr std::size_t kMaxNumber = std::numeric_limits<T>::max_digits10 + 8;
+  int rows_per_piece = std::max<std::size_t>(
+      1, s21::kTextChunkBytes / ((kMaxNumber + 1) * std::max(cols_, 1)));
+  s21::ThreadPool &pool = s21::ThreadPool::Instance();
+  std::vector<std::string> pieces(pool.GetThreadCount() * 2);
+  int batch_rows = rows_per_piece * static_cast<int>(pieces.size());
+  for (int first = 0; first < rows_; first += batch_rows) {
+    int last = std::min(rows_, first + batch_rows);
+    int count = (last - first + rows_per_piece - 1) / rows_per_piece;
+    pool.ParallelFor(count, [&, first, last](int piece) {
+      std::string &out = pieces[piece];
+      out.resize((kMaxNumber + 1) * cols_ * rows_per_piece);
+      char *p = out.data();
+      int row = first + piece * rows_per_piece;
+      int stop = std::min(last, row + rows_per_piece);
+      for (; row < stop; row++) {
+        for (int j = 0; j < cols_; j++) {
+          p = std::to_chars(p, p + kMaxNumber, Row(row)[j]).ptr;
+          *p++ = j + 1 < cols_ ? delimiter : '\n';
+        }
+      }
+      out.resize(p - out.data());
+    });
+    for (int piece = 0; piece < count; piece++)
+      file.write(pieces[piece].data(), pieces[piece].size());
+  }
+  if (!file.flush())
+    throw std::runtime_error("Error: Cannot write matrix file.");
+}
+
+template void S21BasicMatrix<float>::Save(const std::string &) const;
+template void S21BasicMatrix<double>::Save(const std::string &) const;
+template void S21BasicMatrix<long double>::Save(const std::string &) const;
+template S21BasicMatrix<float> S21BasicMatrix<float>::Load(
+    const std::string &);
+template S21BasicMatrix<double> S21BasicMatrix<double>::Load(
+    const std::string &);
+template S21BasicMatrix<long double> S21BasicMatrix<long double>::Load(
+    const std::string &);
+template S21BasicMatrix<float> S21BasicMatrix<float>::Map(const std::string &,
+                                                          s21::MapMode);
+template S21BasicMatrix<double> S21BasicMatrix<double>::Map(
+    const std::string &, s21::MapMode);
+template S21BasicMatrix<long double> S21BasicMatrix<long double>::Map(
+    const std::string &, s21::MapMode);
+template bool S21BasicMatrix<float>::Mapped() const noexcept;
+template bool S21BasicMatrix<double>::Mapped() const noexcept;
+template bool S21BasicMatrix<long double>::Mapped() const noexcept;
+template S21BasicMatrix<float> S21BasicMatrix<float>::ParseText(
+    std::string_view);
+template S21BasicMatrix<double> S21BasicMatrix<double>::ParseText(
+    std::string_view);
+template S21BasicMatrix<long double> S21BasicMatrix<long double>::ParseText(
+    std::string_view);
+template S21BasicMatrix<float> S21BasicMatrix<float>::LoadText(
+    const std::string &);
+template S21BasicMatrix<double> S21BasicMatrix<double>::LoadText(
+    const std::string &);
+template S21BasicMatrix<long double> S21BasicMatrix<long double>::LoadText(
+    const std::string &);
+template void S21BasicMatrix<float>::SaveText(const std::string &, char) const;
+template void S21BasicMatrix<double>::SaveText(const std::string &, char) const;
+template void S21BasicMatrix<long double>::SaveText(const std::string &,
+                                                    char) const;
@@ -0,0 +1,74 @@
+#ifndef SRC_S21_MATRIX_IO_H_
+#define SRC_S21_MATRIX_IO_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "s21_matrix_oop.h"
+
+namespace s21 {
+
+// Binary matrix file, all fields in host byte order:
+//
+//   offset  size  field
+//        0     8  magic "S21MATRX"
+//        8     4  format version (kMatrixFileVersion)
+//       12     4  element type (kMatrixFileFloat32, kMatrixFileFloat64 or
+//                 kMatrixFileLongDouble)
+//       16     8  rows
+//       24     8  cols
+//       32     8  row stride in elements, at least cols
+//       40     8  offset of the first element, a multiple of the page size
+//       48     8  checksum of the element block (MatrixChecksum)
+//
+// The element block holds rows * stride elements laid out exactly as
+// S21BasicMatrix keeps them in memory, so a file can be read with a single
+// read() or mapped and used in place. Long double elements are stored in
+// the format of the host; on x86-64 that is the 80-bit extended format
+// padded to 16 bytes.
+constexpr std::uint32_t kMatrixFileVersion = 1;
+constexpr std::uint32_t kMatrixFileFloat64 = 1;
+constexpr std::uint32_t kMatrixFileFloat32 = 2;
+constexpr std::uint32_t kMatrixFileLongDouble = 3;
+constexpr std::uint64_t kMatrixFileDataOffset = 4096;
+
+struct MatrixFileHeader {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t dtype;
+  std::int64_t rows, cols, stride;
+  std::uint64_t data_offset;
+  std::uint64_t checksum;
+};
+
+// FNV-1a over 64-bit words of a block of bytes, a partial last word being
+// padded with zeros. Passing the result of one call as the hash of the next
+// checksums a block in pieces of whole words.
+constexpr std::uint64_t kMatrixChecksumSeed = 14695981039346656037ULL;
+std::uint64_t MatrixChecksum(const void *data, std::size_t bytes,
+                             std::uint64_t hash = kMatrixChecksumSeed) noexcept;
+
+// Read-write mapping of a whole matrix file, owned by the S21BasicMatrix
+// that wraps it. Any row stride and element type is accepted; Data() points
+// to the first element. The header is validated but the
+// checksum is not: checking it would page in the whole file.
+class FileMapping {
+ public:
+  FileMapping(const std::string &path, MapMode mode);
+  ~FileMapping();
+  FileMapping(const FileMapping &) = delete;
+  FileMapping &operator=(const FileMapping &) = delete;
+
+  const MatrixFileHeader &Header() const noexcept;
+  void *Data() const noexcept;
+
+ private:
+  void *base_;
+  std::size_t bytes_;
+  MapMode mode_;
+};
+
+}  // namespace s21
+
+#endif  // SRC_S21_MATRIX_IO_H_
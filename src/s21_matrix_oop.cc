@@ -1,153 +1,169 @@
 #include "s21_matrix_oop.h"
 
-S21Matrix::S21Matrix() : rows_(0), cols_(0), matrix_(nullptr) {}
-
-S21Matrix::~S21Matrix() {
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "s21_gemm.h"
+#include "s21_lu.h"
+#include "s21_matrix_io.h"
+#include "s21_simd.h"
+#include "s21_strassen.h"
+#include "s21_transpose.h"
+
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix()
+    : rows_(0), cols_(0), stride_(0), matrix_(nullptr) {}
+
+template <typename T>
+S21BasicMatrix<T>::~S21BasicMatrix() {
   RemoveMatrix();
   rows_ = 0;
   cols_ = 0;
 }
 
-S21Matrix::S21Matrix(int rows, int cols) : rows_(rows), cols_(cols) {
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(int rows, int cols)
+    : rows_(rows), cols_(cols), stride_(0), matrix_(nullptr) {
   if (rows <= 0 || cols <= 0)
     throw std::invalid_argument("Invalid parameter for rows or cols.");
   CreateMatrix();
 }
 
-S21Matrix::S21Matrix(const S21Matrix &other)
-    : rows_(other.rows_), cols_(other.cols_) {
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(const S21BasicMatrix &other)
+    : rows_(other.rows_), cols_(other.cols_), stride_(0), matrix_(nullptr) {
   CreateMatrix();
   CopyMatrix(other);
 }
 
-S21Matrix::S21Matrix(S21Matrix &&other)
-    : rows_(other.rows_), cols_(other.cols_), matrix_(other.matrix_) {
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(S21BasicMatrix &&other)
+    : rows_(other.rows_),
+      cols_(other.cols_),
+      stride_(other.stride_),
+      matrix_(other.matrix_),
+      bytes_(other.bytes_),
+      mapping_(other.mapping_) {
   other.MoveMatrix();
 }
 
-S21Matrix S21Matrix::operator+(const S21Matrix &other) {
-  if (!SameMatrixSize(other))
-    throw std::logic_error(
-        "Error: Matrices should be the same size of rows and columns.");
-  S21Matrix result = *this;
-  result.SumMatrix(other);
-  return result;
-}
-
-S21Matrix S21Matrix::operator-(const S21Matrix &other) {
-  if (!SameMatrixSize(other))
-    throw std::logic_error(
-        "Error: Matrices should be the same size of rows and columns.");
-  S21Matrix result = *this;
-  result.SubMatrix(other);
-  return result;
-}
-
-S21Matrix &S21Matrix::operator=(S21Matrix &&other) {
+template <typename T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator=(S21BasicMatrix &&other) {
   if (this != &other) {
     RemoveMatrix();
     std::swap(rows_, other.rows_);
     std::swap(cols_, other.cols_);
+    std::swap(stride_, other.stride_);
     std::swap(matrix_, other.matrix_);
+    std::swap(bytes_, other.bytes_);
+    std::swap(mapping_, other.mapping_);
     other.MoveMatrix();
   }
   return *this;
 }
 
-S21Matrix &S21Matrix::operator=(S21Matrix &other) {
+template <typename T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator=(
+    const S21BasicMatrix &other) {
   if (this != &other) {
-    RemoveMatrix();
-    rows_ = other.rows_;
-    cols_ = other.cols_;
-    CreateMatrix();
+    if (!SameMatrixSize(other) || !matrix_) {
+      RemoveMatrix();
+      rows_ = other.rows_;
+      cols_ = other.cols_;
+      CreateMatrix();
+    }
     CopyMatrix(other);
   }
   return *this;
 }
 
-S21Matrix S21Matrix::operator*(const double num) noexcept {
-  S21Matrix result(rows_, cols_);
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      result.matrix_[i][j] = matrix_[i][j] * num;
-    }
-  }
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::operator*(
+    const S21BasicMatrix &other) const {
+  if (cols_ != other.rows_)
+    throw std::logic_error(
+        "Error: Rows of first matrix should be equal with columns of second "
+        "matrix.");
+  S21BasicMatrix result(rows_, other.cols_);
+  result.View().AssignProduct(View(), other.View());
   return result;
 }
 
-S21Matrix S21Matrix::operator*(const S21Matrix &other) {
-  MulMatrix(other);
-  return *this;
-}
-
-S21Matrix S21Matrix::operator+=(const S21Matrix &other) {
+template <typename T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator+=(
+    const S21BasicMatrix &other) {
   if (!SameMatrixSize(other))
     throw std::logic_error("Error: You can't sum matrices of different size");
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      matrix_[i][j] += other.matrix_[i][j];
-    }
-  }
+  for (int i = 0; i < rows_; i++) s21::simd::Add(cols_, other.Row(i), Row(i));
   return *this;
 }
 
-S21Matrix S21Matrix::operator-=(const S21Matrix &other) {
+template <typename T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator-=(
+    const S21BasicMatrix &other) {
   if (!SameMatrixSize(other))
     throw std::logic_error("Error: You can't sub matrices of different size");
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      matrix_[i][j] -= other.matrix_[i][j];
-    }
-  }
+  for (int i = 0; i < rows_; i++) s21::simd::Sub(cols_, other.Row(i), Row(i));
   return *this;
 }
 
-S21Matrix S21Matrix::operator*=(const double num) noexcept {
-  *this = *this * num;
+template <typename T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator*=(const T num) noexcept {
+  for (int i = 0; i < rows_; i++) s21::simd::Scale(cols_, num, Row(i));
   return *this;
 }
 
-S21Matrix S21Matrix::operator*=(const S21Matrix &other) {
-  *this = *this * other;
+template <typename T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator*=(
+    const S21BasicMatrix &other) {
+  MulMatrix(other);
   return *this;
 }
 
-double &S21Matrix::operator()(int rows, int cols) {
+template <typename T>
+T &S21BasicMatrix<T>::operator()(int rows, int cols) {
   if (rows < 0 || cols < 0 || rows >= rows_ || cols >= cols_)
     throw std::range_error("Error: You try to put value out of matrix.");
-  return matrix_[rows][cols];
+  return Row(rows)[cols];
 }
 
-double &S21Matrix::operator()(int rows, int cols) const {
+template <typename T>
+T &S21BasicMatrix<T>::operator()(int rows, int cols) const {
   if (rows < 0 || cols < 0 || rows >= rows_ || cols >= cols_)
     throw std::range_error("Error: You try to put value out of matrix.");
-  return matrix_[rows][cols];
+  return Row(rows)[cols];
 }
 
-bool S21Matrix::operator==(const S21Matrix &other) const noexcept {
+template <typename T>
+bool S21BasicMatrix<T>::operator==(
+    const S21BasicMatrix &other) const noexcept {
   if (!SameMatrixSize(other)) return false;
   for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      if (std::abs(matrix_[i][j] - other.matrix_[i][j]) > pow(10, -7))
-        return false;
-    }
+    if (!s21::simd::Near(cols_, Row(i), other.Row(i),
+                         s21::kEqualityToleranceFor<T>))
+      return false;
   }
   return true;
 }
 
-int S21Matrix::GetRows() const noexcept { return rows_; }
+template <typename T>
+int S21BasicMatrix<T>::GetRows() const noexcept { return rows_; }
 
-int S21Matrix::GetCols() const noexcept { return cols_; }
+template <typename T>
+int S21BasicMatrix<T>::GetCols() const noexcept { return cols_; }
 
-void S21Matrix::SetRows(int rows) {
+template <typename T>
+void S21BasicMatrix<T>::SetRows(int rows) {
   if (rows <= 0)
     throw std::logic_error("Error: Rows can't be less or equal 0.");
   if (matrix_) {
-    S21Matrix tmp(rows, cols_);
+    S21BasicMatrix tmp(rows, cols_);
     int limit_row = rows > rows_ ? rows_ : rows;
     for (int i = 0; i < limit_row; i++) {
       for (int j = 0; j < cols_; j++) {
-        tmp.matrix_[i][j] = matrix_[i][j];
+        tmp.Row(i)[j] = Row(i)[j];
       }
     }
     *this = std::move(tmp);
@@ -158,15 +174,16 @@ void S21Matrix::SetRows(int rows) {
   }
 }
 
-void S21Matrix::SetCols(int cols) {
+template <typename T>
+void S21BasicMatrix<T>::SetCols(int cols) {
   if (cols <= 0)
     throw std::logic_error("Error: Cols can't be less or equal 0.");
   if (matrix_) {
-    S21Matrix tmp(rows_, cols);
+    S21BasicMatrix tmp(rows_, cols);
     int limit_col = cols > cols_ ? cols_ : cols;
     for (int i = 0; i < rows_; i++) {
       for (int j = 0; j < limit_col; j++) {
-        tmp.matrix_[i][j] = matrix_[i][j];
+        tmp.Row(i)[j] = Row(i)[j];
       }
     }
     *this = std::move(tmp);
@@ -177,101 +194,223 @@ void S21Matrix::SetCols(int cols) {
   }
 }
 
-bool S21Matrix::EqMatrix(const S21Matrix &other) const noexcept {
+template <typename T>
+bool S21BasicMatrix<T>::EqMatrix(const S21BasicMatrix &other) const noexcept {
   return *this == other;
 }
 
-void S21Matrix::SumMatrix(const S21Matrix &other) { *this += other; }
+template <typename T>
+bool S21BasicMatrix<T>::EqMatrix(
+    const s21::BasicConstMatrixView<T> &other) const noexcept {
+  return View().EqMatrix(other);
+}
 
-void S21Matrix::SubMatrix(const S21Matrix &other) { *this -= other; }
+template <typename T>
+void S21BasicMatrix<T>::SumMatrix(const S21BasicMatrix &other) {
+  *this += other;
+}
 
-void S21Matrix::MulNumber(const double num) noexcept { *this *= num; }
+template <typename T>
+void S21BasicMatrix<T>::SumMatrix(const s21::BasicConstMatrixView<T> &other) {
+  View().SumMatrix(other);
+}
 
-void S21Matrix::MulMatrix(const S21Matrix &other) {
-  if (cols_ != other.rows_)
+template <typename T>
+void S21BasicMatrix<T>::SubMatrix(const S21BasicMatrix &other) {
+  *this -= other;
+}
+
+template <typename T>
+void S21BasicMatrix<T>::SubMatrix(const s21::BasicConstMatrixView<T> &other) {
+  View().SubMatrix(other);
+}
+
+template <typename T>
+void S21BasicMatrix<T>::MulNumber(const T num) noexcept { *this *= num; }
+
+template <typename T>
+void S21BasicMatrix<T>::MulMatrix(const S21BasicMatrix &other,
+                                  s21::MulAlgorithm algorithm) {
+  MulMatrix(other.View(), algorithm);
+}
+
+template <typename T>
+void S21BasicMatrix<T>::MulMatrix(const s21::BasicConstMatrixView<T> &other,
+                                  s21::MulAlgorithm algorithm) {
+  if (cols_ != other.GetRows())
     throw std::logic_error(
         "Error: Rows of first matrix should be equal with columns of second "
         "matrix.");
-  S21Matrix tmp(rows_, other.cols_);
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < other.cols_; j++) {
-      for (int k = 0; k < cols_; k++) {
-        tmp.matrix_[i][j] += matrix_[i][k] * other.matrix_[k][j];
-      }
-    }
-  }
+  S21BasicMatrix tmp(rows_, other.GetCols());
+  tmp.View().AssignProduct(View(), other, algorithm);
   *this = std::move(tmp);
 }
 
-S21Matrix S21Matrix::Transpose() const noexcept {
-  S21Matrix res(cols_, rows_);
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      res.matrix_[j][i] = matrix_[i][j];
-    }
-  }
+template <typename T>
+void S21BasicMatrix<T>::Gemm(T alpha, const s21::BasicConstMatrixView<T> &lhs,
+                             const s21::BasicConstMatrixView<T> &rhs, T beta,
+                             s21::MulAlgorithm algorithm) {
+  View().Gemm(alpha, lhs, rhs, beta, algorithm);
+}
+
+template <typename T>
+void S21BasicMatrix<T>::Axpy(T alpha,
+                             const s21::BasicConstMatrixView<T> &other) {
+  View().Axpy(alpha, other);
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Transpose() const noexcept {
+  S21BasicMatrix res(cols_, rows_);
+  s21::Transpose(rows_, cols_, matrix_, stride_, res.matrix_, res.stride_);
   return res;
 }
 
-double S21Matrix::Determinant() const {
+// Square matrices keep their stride and swap tiles. Rectangular ones are
+// packed densely, permuted along cycles and spread out to the new stride,
+// which works whenever the transposed layout fits in the current buffer;
+// otherwise a transposed copy replaces the matrix.
+template <typename T>
+void S21BasicMatrix<T>::TransposeInPlace() {
+  if (!matrix_) return;
+  if (SquareMatrix()) {
+    s21::TransposeSquareInPlace(rows_, matrix_, stride_);
+    return;
+  }
+  // A mapped file keeps its layout, so mapped matrices move to the heap.
+  int stride = (rows_ + kStrideStep - 1) / kStrideStep * kStrideStep;
+  if (mapping_ || static_cast<std::size_t>(cols_) * stride >
+                      static_cast<std::size_t>(rows_) * stride_) {
+    *this = Transpose();
+    return;
+  }
+  for (int i = 1; i < rows_; i++)
+    std::copy(Row(i), Row(i) + cols_, matrix_ + i * cols_);
+  s21::TransposeDenseInPlace(rows_, cols_, matrix_);
+  for (int i = cols_ - 1; i >= 0; i--) {
+    T *row = matrix_ + i * stride;
+    std::copy_backward(matrix_ + i * rows_, matrix_ + (i + 1) * rows_,
+                       row + rows_);
+    std::fill(row + rows_, row + stride, T(0));
+  }
+  std::swap(rows_, cols_);
+  stride_ = stride;
+}
+
+template <typename T>
+T S21BasicMatrix<T>::Determinant(s21::Factorization factorization) const {
   if (!SquareMatrix())
     throw std::length_error("Error: Matrix should be square.");
-  double determinant = 0.0;
+  if (rows_ == 0 || rows_ > 3 ||
+      factorization == s21::Factorization::kCholesky)
+    return FactoredDeterminant(factorization);
+  T determinant = 0;
   if (rows_ == 1) {
-    determinant = matrix_[0][0];
+    determinant = Row(0)[0];
   } else if (rows_ == 2) {
-    determinant =
-        (matrix_[0][0] * matrix_[1][1] - matrix_[1][0] * matrix_[0][1]);
-  } else {
-    int index = 1;
-    for (int i = 0; i < rows_; i++) {
-      S21Matrix Minor = MinorMatrix(i, 0);
-      determinant += index * matrix_[i][0] * Minor.Determinant();
-      index = -index;
-    }
+    determinant = (Row(0)[0] * Row(1)[1] - Row(1)[0] * Row(0)[1]);
+  } else if (rows_ == 3) {
+    const T *a = Row(0), *b = Row(1), *c = Row(2);
+    determinant = a[0] * (b[1] * c[2] - b[2] * c[1]) -
+                  a[1] * (b[0] * c[2] - b[2] * c[0]) +
+                  a[2] * (b[0] * c[1] - b[1] * c[0]);
+  }
+  return determinant;
+}
+
+template <typename T>
+T S21BasicMatrix<T>::FactoredDeterminant(
+    s21::Factorization factorization) const {
+  S21BasicMatrix factors(*this);
+  if (CholeskyFactors(factorization, PivotTolerance(), factors)) {
+    T root = 1;
+    for (int i = 0; i < rows_; i++) root *= factors.Row(i)[i];
+    return root * root;
   }
+  std::vector<int> pivots(rows_);
+  T determinant =
+      s21::LuFactor(rows_, factors.matrix_, factors.stride_, pivots.data());
+  for (int i = 0; i < rows_ && determinant; i++)
+    determinant *= factors.Row(i)[i];
   return determinant;
 }
 
-S21Matrix S21Matrix::CalcComplements() const {
+template <typename T>
+T S21BasicMatrix<T>::LogDeterminant(s21::Factorization factorization) const {
+  if (!SquareMatrix())
+    throw std::length_error("Error: Matrix should be square.");
+  S21BasicMatrix factors(*this);
+  T log_determinant = 0;
+  if (CholeskyFactors(factorization, PivotTolerance(), factors)) {
+    for (int i = 0; i < rows_; i++)
+      log_determinant += std::log(factors.Row(i)[i]);
+    return 2 * log_determinant;
+  }
+  std::vector<int> pivots(rows_);
+  if (!s21::LuFactor(rows_, factors.matrix_, factors.stride_, pivots.data()))
+    return -std::numeric_limits<T>::infinity();
+  for (int i = 0; i < rows_; i++)
+    log_determinant += std::log(std::abs(factors.Row(i)[i]));
+  return log_determinant;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::CalcComplements() const {
   if (!SquareMatrix() && rows_ > 1 && cols_ > 1)
     throw std::logic_error("Error: Matrix should be square.");
-  S21Matrix result(rows_, cols_);
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      S21Matrix Minor = MinorMatrix(i, j);
-      result.matrix_[i][j] = ((i + j) % 2 ? -1 : 1) * Minor.Determinant();
+  if (!SquareMatrix() || rows_ <= kMinorExpansionLimit)
+    return MinorComplements();
+  // For a nonsingular matrix the cofactors are det(A) * (A^-1)^T.
+  T tolerance = PivotTolerance();
+  S21BasicMatrix inverse(*this);
+  std::vector<int> pivots(rows_);
+  T determinant = 0;
+  if (s21::InvertInPlace(rows_, inverse.matrix_, inverse.stride_,
+                         pivots.data(), tolerance, &determinant)) {
+    S21BasicMatrix result(rows_, cols_);
+    for (int i = 0; i < rows_; i++) {
+      for (int j = 0; j < cols_; j++)
+        result.Row(i)[j] = determinant * inverse.Row(j)[i];
     }
+    return result;
   }
-  return result;
+  // Every (n-1) x (n-1) minor of a matrix of rank below n-1 vanishes.
+  S21BasicMatrix reduced(*this);
+  if (s21::RankInPlace(rows_, reduced.matrix_, reduced.stride_, tolerance) <
+      rows_ - 1)
+    return S21BasicMatrix(rows_, cols_);
+  return MinorComplements();
 }
 
-S21Matrix S21Matrix::InverseMatrix() const {
-  double determinant = Determinant();
-  if (!determinant)
-    throw std::logic_error("Error: Matrix is not square or determinant is 0.");
-  S21Matrix result(rows_, cols_);
-  if (rows_ == 1 && cols_ == 1) {
-    result.matrix_[0][0] = 1 / determinant;
-  } else {
-    S21Matrix transpose = CalcComplements().Transpose();
-    for (int i = 0; i < rows_; i++) {
-      for (int j = 0; j < cols_; j++) {
-        result.matrix_[i][j] = transpose.matrix_[i][j] / determinant;
-      }
-    }
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::InverseMatrix(
+    s21::Factorization factorization) const {
+  if (!SquareMatrix())
+    throw std::length_error("Error: Matrix should be square.");
+  T tolerance = PivotTolerance();
+  S21BasicMatrix result(*this);
+  if (CholeskyFactors(factorization, tolerance, result)) {
+    S21BasicMatrix inverse(rows_, cols_);
+    s21::CholeskyInvert(rows_, result.matrix_, result.stride_, inverse.matrix_,
+                        inverse.stride_);
+    return inverse;
   }
+  std::vector<int> pivots(rows_);
+  if (!s21::InvertInPlace(rows_, result.matrix_, result.stride_, pivots.data(),
+                          tolerance))
+    throw std::logic_error("Error: Matrix is not square or determinant is 0.");
   return result;
 }
 
-S21Matrix S21Matrix::MinorMatrix(int rows, int cols) const {
-  S21Matrix minor(rows_ - 1, cols_ - 1);
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::MinorMatrix(int rows, int cols) const {
+  S21BasicMatrix minor(rows_ - 1, cols_ - 1);
   int minor_row = 0, minor_col = 0;
   for (int i = 0; i < rows_; i++) {
     if (i != rows) {
       for (int j = 0; j < cols_; j++) {
         if (j != cols) {
-          minor.matrix_[minor_row][minor_col] = matrix_[i][j];
+          minor.Row(minor_row)[minor_col] = Row(i)[j];
           minor_col++;
         }
       }
@@ -284,42 +423,401 @@ S21Matrix S21Matrix::MinorMatrix(int rows, int cols) const {
   return minor;
 }
 
-bool S21Matrix::SameMatrixSize(const S21Matrix &other) const noexcept {
-  return (rows_ == other.rows_ && cols_ == other.cols_);
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::MinorComplements() const {
+  S21BasicMatrix result(rows_, cols_);
+  for (int i = 0; i < rows_; i++) {
+    for (int j = 0; j < cols_; j++) {
+      S21BasicMatrix Minor = MinorMatrix(i, j);
+      result.Row(i)[j] = ((i + j) % 2 ? -1 : 1) * Minor.Determinant();
+    }
+  }
+  return result;
 }
 
-bool S21Matrix::SquareMatrix() const { return rows_ == cols_; }
+// Replaces factors, a copy of this matrix, with its Cholesky factor where
+// the hint allows. Positive definiteness only shows once the factorization
+// gets through: under kAuto a failed attempt restores the copy for LU,
+// under kCholesky it throws.
+template <typename T>
+bool S21BasicMatrix<T>::CholeskyFactors(s21::Factorization factorization,
+                                        T tolerance,
+                                        S21BasicMatrix &factors) const {
+  if (!s21::TryCholesky(factorization, *this, tolerance)) return false;
+  if (s21::CholeskyFactor(rows_, factors.matrix_, factors.stride_, tolerance))
+    return true;
+  if (factorization == s21::Factorization::kCholesky)
+    throw std::logic_error("Error: Matrix is not positive definite.");
+  factors = *this;
+  return false;
+}
 
-void S21Matrix::FillMatrix(double num) noexcept {
+// Pivots below this bound are indistinguishable from rounding noise of the
+// largest element.
+template <typename T>
+T S21BasicMatrix<T>::PivotTolerance() const noexcept {
+  T max_abs = 0;
   for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      matrix_[i][j] += num;
-    }
+    for (int j = 0; j < cols_; j++)
+      max_abs = std::max(max_abs, std::abs(Row(i)[j]));
   }
+  return rows_ * std::numeric_limits<T>::epsilon() * max_abs;
+}
+
+template <typename T>
+bool S21BasicMatrix<T>::SameMatrixSize(
+    const S21BasicMatrix &other) const noexcept {
+  return (rows_ == other.rows_ && cols_ == other.cols_);
+}
+
+template <typename T>
+bool S21BasicMatrix<T>::SquareMatrix() const { return rows_ == cols_; }
+
+template <typename T>
+void S21BasicMatrix<T>::FillMatrix(T num) noexcept {
+  for (int i = 0; i < rows_; i++) s21::simd::Shift(cols_, num, Row(i));
+}
+
+template <typename T>
+s21::BasicConstMatrixView<T> S21BasicMatrix<T>::View() const noexcept {
+  return s21::BasicConstMatrixView<T>(matrix_, rows_, cols_, stride_);
+}
+
+template <typename T>
+s21::BasicMatrixView<T> S21BasicMatrix<T>::View() noexcept {
+  return s21::BasicMatrixView<T>(matrix_, rows_, cols_, stride_);
+}
+
+template <typename T>
+s21::BasicConstMatrixView<T> S21BasicMatrix<T>::Block(int row, int col,
+                                                     int rows, int cols) const {
+  return View().Block(row, col, rows, cols);
+}
+
+template <typename T>
+s21::BasicMatrixView<T> S21BasicMatrix<T>::Block(int row, int col, int rows,
+                                                int cols) {
+  return View().Block(row, col, rows, cols);
+}
+
+template <typename T>
+s21::BasicConstMatrixView<T> S21BasicMatrix<T>::RowView(int row) const {
+  return View().RowView(row);
+}
+
+template <typename T>
+s21::BasicMatrixView<T> S21BasicMatrix<T>::RowView(int row) {
+  return View().RowView(row);
+}
+
+template <typename T>
+s21::BasicConstMatrixView<T> S21BasicMatrix<T>::ColView(int col) const {
+  return View().ColView(col);
 }
 
-bool S21Matrix::CheckNullptr() { return matrix_ == nullptr; }
+template <typename T>
+s21::BasicMatrixView<T> S21BasicMatrix<T>::ColView(int col) {
+  return View().ColView(col);
+}
 
-void S21Matrix::CopyMatrix(const S21Matrix &other) {
+template <typename T>
+s21::BasicConstMatrixView<T> S21BasicMatrix<T>::TransposedView()
+    const noexcept {
+  return View().Transpose();
+}
+
+template <typename T>
+s21::BasicMatrixView<T> S21BasicMatrix<T>::TransposedView() noexcept {
+  return View().Transpose();
+}
+
+template <typename T>
+bool S21BasicMatrix<T>::CheckNullptr() { return matrix_ == nullptr; }
+
+template <typename T>
+void S21BasicMatrix<T>::CopyMatrix(const S21BasicMatrix &other) {
+  if (stride_ == other.stride_) {
+    std::copy(other.matrix_, other.matrix_ + rows_ * stride_, matrix_);
+    return;
+  }
   for (int i = 0; i < rows_; i++)
-    std::copy(other.matrix_[i], other.matrix_[i] + other.cols_, matrix_[i]);
+    std::copy(other.Row(i), other.Row(i) + cols_, Row(i));
 }
 
-void S21Matrix::MoveMatrix() {
+template <typename T>
+void S21BasicMatrix<T>::MoveMatrix() {
   rows_ = 0;
   cols_ = 0;
+  stride_ = 0;
   matrix_ = nullptr;
+  bytes_ = 0;
+  mapping_ = nullptr;
 }
 
-void S21Matrix::CreateMatrix() {
-  matrix_ = new double *[rows_]();
-  for (int i = 0; i < rows_; i++) matrix_[i] = new double[cols_]();
+template <typename T>
+void S21BasicMatrix<T>::CreateMatrix() {
+  stride_ = (cols_ + kStrideStep - 1) / kStrideStep * kStrideStep;
+  std::size_t size = static_cast<std::size_t>(rows_) * stride_;
+  bytes_ = size * sizeof(T);
+  matrix_ = static_cast<T *>(s21::MatrixPool::Allocate(bytes_));
+  // All-zero bytes are 0.0 in every element type and also clear the padding
+  // bytes of long double, which files then store deterministically.
+  std::memset(matrix_, 0, size * sizeof(T));
 }
 
-void S21Matrix::RemoveMatrix() {
-  if (matrix_) {
-    for (int i = 0; i < rows_; i++) delete[] matrix_[i];
-    delete[] matrix_;
+template <typename T>
+void S21BasicMatrix<T>::RemoveMatrix() {
+  if (mapping_) {
+    delete mapping_;
+    mapping_ = nullptr;
+    matrix_ = nullptr;
+  } else if (matrix_) {
+    s21::MatrixPool::Release(matrix_, bytes_);
     matrix_ = nullptr;
+    bytes_ = 0;
+  }
+}
+
+namespace s21 {
+
+namespace {
+
+// Below this size kAuto factors with LU without checking for symmetry: the
+// check and the extra buffers cost more than Cholesky saves.
+constexpr int kAutoCholeskyLimit = 16;
+
+}  // namespace
+
+template <typename T>
+bool TryCholesky(Factorization factorization, const S21BasicMatrix<T> &a,
+                 T tolerance) {
+  if (factorization != Factorization::kAuto)
+    return factorization == Factorization::kCholesky;
+  BasicConstMatrixView<T> matrix = a.View();
+  return a.GetRows() >= kAutoCholeskyLimit &&
+         Symmetric(a.GetRows(), matrix.Data(), matrix.GetRowStride(),
+                   tolerance);
+}
+
+template <typename T>
+BasicConstMatrixView<T>::BasicConstMatrixView(
+    const S21BasicMatrix<T> &matrix) noexcept
+    : BasicConstMatrixView(matrix.View()) {}
+
+template <typename T>
+const T &BasicConstMatrixView<T>::operator()(int row, int col) const {
+  if (row < 0 || col < 0 || row >= rows_ || col >= cols_)
+    throw std::range_error("Error: You try to put value out of matrix.");
+  return data_[row * row_stride_ + col * col_stride_];
+}
+
+template <typename T>
+void BasicConstMatrixView<T>::CheckBlock(int row, int col, int rows,
+                                         int cols) const {
+  if (row < 0 || col < 0 || rows <= 0 || cols <= 0 || row + rows > rows_ ||
+      col + cols > cols_)
+    throw std::range_error("Error: Block is out of matrix.");
+}
+
+template <typename T>
+BasicConstMatrixView<T> BasicConstMatrixView<T>::Block(int row, int col,
+                                                       int rows,
+                                                       int cols) const {
+  CheckBlock(row, col, rows, cols);
+  return BasicConstMatrixView(data_ + row * row_stride_ + col * col_stride_,
+                              rows, cols, row_stride_, col_stride_);
+}
+
+template <typename T>
+bool BasicConstMatrixView<T>::EqMatrix(
+    const BasicConstMatrixView &other) const noexcept {
+  constexpr T tolerance = kEqualityToleranceFor<T>;
+  if (!SameMatrixSize(other)) return false;
+  for (int i = 0; i < rows_; i++) {
+    const T *row = data_ + i * row_stride_;
+    const T *other_row = other.data_ + i * other.row_stride_;
+    if (col_stride_ == 1 && other.col_stride_ == 1) {
+      if (!simd::Near(cols_, row, other_row, tolerance)) return false;
+    } else {
+      for (int j = 0; j < cols_; j++) {
+        T diff = row[j * col_stride_] - other_row[j * other.col_stride_];
+        if (std::abs(diff) > tolerance) return false;
+      }
+    }
+  }
+  return true;
+}
+
+template <typename T>
+T BasicConstMatrixView<T>::Determinant(Factorization factorization) const {
+  return S21BasicMatrix<T>(*this).Determinant(factorization);
+}
+
+template <typename T>
+BasicMatrixView<T> &BasicMatrixView<T>::operator=(
+    const BasicMatrixView &other) {
+  Assign(other);
+  return *this;
+}
+
+template <typename T>
+BasicMatrixView<T> &BasicMatrixView<T>::operator=(
+    const BasicConstMatrixView<T> &other) {
+  Assign(other);
+  return *this;
+}
+
+template <typename T>
+BasicMatrixView<T> BasicMatrixView<T>::Block(int row, int col, int rows,
+                                             int cols) const {
+  this->CheckBlock(row, col, rows, cols);
+  return BasicMatrixView(data_ + row * row_stride_ + col * col_stride_, rows,
+                         cols, row_stride_, col_stride_);
+}
+
+template <typename T>
+void BasicMatrixView<T>::SumMatrix(
+    const BasicConstMatrixView<T> &other) const {
+  if (!this->SameMatrixSize(other))
+    throw std::logic_error("Error: You can't sum matrices of different size");
+  for (int i = 0; i < rows_; i++) {
+    T *row = data_ + i * row_stride_;
+    const T *other_row = other.Data() + i * other.GetRowStride();
+    if (col_stride_ == 1 && other.GetColStride() == 1) {
+      simd::Add(cols_, other_row, row);
+    } else {
+      for (int j = 0; j < cols_; j++)
+        row[j * col_stride_] += other_row[j * other.GetColStride()];
+    }
   }
-}
\ No newline at end of file
+}
+
+template <typename T>
+void BasicMatrixView<T>::SubMatrix(
+    const BasicConstMatrixView<T> &other) const {
+  if (!this->SameMatrixSize(other))
+    throw std::logic_error("Error: You can't sub matrices of different size");
+  for (int i = 0; i < rows_; i++) {
+    T *row = data_ + i * row_stride_;
+    const T *other_row = other.Data() + i * other.GetRowStride();
+    if (col_stride_ == 1 && other.GetColStride() == 1) {
+      simd::Sub(cols_, other_row, row);
+    } else {
+      for (int j = 0; j < cols_; j++)
+        row[j * col_stride_] -= other_row[j * other.GetColStride()];
+    }
+  }
+}
+
+template <typename T>
+void BasicMatrixView<T>::MulNumber(const T num) const noexcept {
+  for (int i = 0; i < rows_; i++) {
+    T *row = data_ + i * row_stride_;
+    if (col_stride_ == 1) {
+      simd::Scale(cols_, num, row);
+    } else {
+      for (int j = 0; j < cols_; j++) row[j * col_stride_] *= num;
+    }
+  }
+}
+
+template <typename T>
+void BasicMatrixView<T>::FillMatrix(T num) const noexcept {
+  for (int i = 0; i < rows_; i++) {
+    T *row = data_ + i * row_stride_;
+    if (col_stride_ == 1) {
+      simd::Shift(cols_, num, row);
+    } else {
+      for (int j = 0; j < cols_; j++) row[j * col_stride_] += num;
+    }
+  }
+}
+
+template <typename T>
+void BasicMatrixView<T>::AssignProduct(const BasicConstMatrixView<T> &lhs,
+                                       const BasicConstMatrixView<T> &rhs,
+                                       MulAlgorithm algorithm) const {
+  Gemm(1, lhs, rhs, 0, algorithm);
+}
+
+template <typename T>
+void BasicMatrixView<T>::Gemm(T alpha, const BasicConstMatrixView<T> &lhs,
+                              const BasicConstMatrixView<T> &rhs, T beta,
+                              MulAlgorithm algorithm) const {
+  if (lhs.GetCols() != rhs.GetRows() || lhs.GetRows() != rows_ ||
+      rhs.GetCols() != cols_)
+    throw std::logic_error(
+        "Error: Rows of first matrix should be equal with columns of second "
+        "matrix.");
+  if (Overlap(*this, lhs) || Overlap(*this, rhs)) {
+    S21BasicMatrix<T> product(rows_, cols_);
+    product.View().Gemm(alpha, lhs, rhs, 0, algorithm);
+    Rescale(beta);
+    Axpy(1, product);
+    return;
+  }
+  int inner = lhs.GetCols();
+  bool row_major = lhs.GetColStride() == 1 && rhs.GetColStride() == 1 &&
+                   col_stride_ == 1;
+  bool strassen = algorithm == MulAlgorithm::kStrassen ||
+                  (algorithm == MulAlgorithm::kAuto &&
+                   PreferStrassen(rows_, cols_, inner));
+  if (strassen && row_major && beta == T(0)) {
+    StrassenGemm(rows_, cols_, inner, lhs.Data(), lhs.GetRowStride(),
+                 rhs.Data(), rhs.GetRowStride(), data_, row_stride_);
+    if (alpha != T(1)) MulNumber(alpha);
+    return;
+  }
+  Rescale(beta);
+  s21::Gemm(rows_, cols_, inner, alpha, lhs.Data(), lhs.GetRowStride(),
+            lhs.GetColStride(), rhs.Data(), rhs.GetRowStride(),
+            rhs.GetColStride(), data_, row_stride_, col_stride_);
+}
+
+template <typename T>
+void BasicMatrixView<T>::Axpy(T alpha,
+                              const BasicConstMatrixView<T> &other) const {
+  if (!this->SameMatrixSize(other))
+    throw std::logic_error("Error: You can't sum matrices of different size");
+  for (int i = 0; i < rows_; i++) {
+    T *row = data_ + i * row_stride_;
+    const T *other_row = other.Data() + i * other.GetRowStride();
+    if (col_stride_ == 1 && other.GetColStride() == 1) {
+      simd::Axpy(cols_, alpha, other_row, row);
+    } else {
+      for (int j = 0; j < cols_; j++)
+        row[j * col_stride_] += alpha * other_row[j * other.GetColStride()];
+    }
+  }
+}
+
+template <typename T>
+void BasicMatrixView<T>::Rescale(T beta) const noexcept {
+  if (beta == T(1)) return;
+  if (beta != T(0)) {
+    MulNumber(beta);
+    return;
+  }
+  for (int i = 0; i < rows_; i++) {
+    for (int j = 0; j < cols_; j++)
+      data_[i * row_stride_ + j * col_stride_] = T(0);
+  }
+}
+
+template bool TryCholesky(Factorization, const S21BasicMatrix<float> &, float);
+template bool TryCholesky(Factorization, const S21BasicMatrix<double> &,
+                          double);
+template bool TryCholesky(Factorization, const S21BasicMatrix<long double> &,
+                          long double);
+template class BasicConstMatrixView<float>;
+template class BasicConstMatrixView<double>;
+template class BasicConstMatrixView<long double>;
+template class BasicMatrixView<float>;
+template class BasicMatrixView<double>;
+template class BasicMatrixView<long double>;
+
+}  // namespace s21
+
+template class S21BasicMatrix<float>;
+template class S21BasicMatrix<double>;
+template class S21BasicMatrix<long double>;
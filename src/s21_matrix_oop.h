@@ -1,33 +1,163 @@
 #ifndef SRC_S21_MATRIX_OOP_H_
 #define SRC_S21_MATRIX_OOP_H_
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "s21_matrix_pool.h"
+
+template <typename T>
+class S21BasicMatrix;
+
+namespace s21 {
+
+// Largest elementwise difference at which EqMatrix still treats matrices of
+// element type T as equal. Single precision carries about seven significant
+// digits, so float matrices compare more loosely than double ones and long
+// double ones more tightly.
+template <typename T>
+inline constexpr T kEqualityToleranceFor = T(1e-7);
+template <>
+inline constexpr float kEqualityToleranceFor<float> = 1e-4f;
+template <>
+inline constexpr long double kEqualityToleranceFor<long double> = 1e-10L;
+constexpr double kEqualityTolerance = kEqualityToleranceFor<double>;
+
+// Matrix product algorithm. kAuto uses Strassen-Winograd for products large
+// enough to profit (see s21_strassen.h) and the blocked kernel otherwise.
+enum class MulAlgorithm { kAuto, kClassical, kStrassen };
+
+// How Determinant, InverseMatrix and Solve factor a square matrix. kAuto
+// uses Cholesky, half the work of LU and no pivoting, on symmetric matrices
+// that are not tiny and falls back to LU when one turns out not to be
+// positive definite.
+// kCholesky skips the symmetry check, reads only the lower triangle and
+// throws std::logic_error instead of falling back.
+enum class Factorization { kAuto, kLu, kCholesky };
+
+// How S21Matrix::Map shares a file. kPrivate keeps writes in memory, copying
+// pages on first write; kShared writes through to the file and refreshes its
+// checksum when the matrix releases the mapping.
+enum class MapMode { kPrivate, kShared };
+
+class FileMapping;
+template <typename T>
+class MatrixRef;
+template <typename T>
+class BasicConstMatrixView;
+template <typename T>
+class BasicMatrixView;
+using ConstMatrixView = BasicConstMatrixView<double>;
+using MatrixView = BasicMatrixView<double>;
+
+template <typename T>
+bool Clobbers(const BasicConstMatrixView<T> &dst,
+              const BasicConstMatrixView<T> &src) noexcept;
+
+template <typename T>
+struct IsMatrixExpr : std::false_type {};
+
+template <typename T>
+using EnableIfMatrixExpr = std::enable_if_t<IsMatrixExpr<T>::value>;
+
+template <typename T>
+struct IsMatrix : std::false_type {};
+
+template <typename T>
+struct IsMatrix<S21BasicMatrix<T>> : std::true_type {};
+
+}  // namespace s21
+
+// Dense matrix of float, double or long double elements. S21Matrix is the
+// double one; S21MatrixF halves the memory traffic and doubles the SIMD
+// width where single precision is enough. Precisions never mix implicitly:
+// operands of one expression share the element type, and a matrix of
+// another type is made with the explicit converting constructor. The
+// members are compiled for the three element types only.
+template <typename T>
+class S21BasicMatrix {
+  static_assert(std::is_floating_point<T>::value,
+                "S21BasicMatrix holds float, double or long double.");
 
-class S21Matrix {
  public:
-  S21Matrix();
-  ~S21Matrix();
-  S21Matrix(int rows, int cols);
-  S21Matrix(const S21Matrix &other);
-  S21Matrix(S21Matrix &&other);
-
-  bool EqMatrix(const S21Matrix &other) const noexcept;
-  void SumMatrix(const S21Matrix &other);
-  void SubMatrix(const S21Matrix &other);
-  void MulNumber(const double num) noexcept;
-  void MulMatrix(const S21Matrix &other);
-  S21Matrix Transpose() const noexcept;
-  S21Matrix CalcComplements() const;
-  double Determinant() const;
-  S21Matrix InverseMatrix() const;
+  using Scalar = T;
+
+  S21BasicMatrix();
+  ~S21BasicMatrix();
+  S21BasicMatrix(int rows, int cols);
+  S21BasicMatrix(const S21BasicMatrix &other);
+  S21BasicMatrix(S21BasicMatrix &&other);
+  template <typename Expr, typename = s21::EnableIfMatrixExpr<Expr>>
+  S21BasicMatrix(const Expr &expr);
+  // Rounds every element of other to T.
+  template <typename U>
+  explicit S21BasicMatrix(const S21BasicMatrix<U> &other);
+
+  bool EqMatrix(const S21BasicMatrix &other) const noexcept;
+  bool EqMatrix(const s21::BasicConstMatrixView<T> &other) const noexcept;
+  void SumMatrix(const S21BasicMatrix &other);
+  void SumMatrix(const s21::BasicConstMatrixView<T> &other);
+  void SubMatrix(const S21BasicMatrix &other);
+  void SubMatrix(const s21::BasicConstMatrixView<T> &other);
+  void MulNumber(const T num) noexcept;
+  void MulMatrix(const S21BasicMatrix &other,
+                 s21::MulAlgorithm algorithm = s21::MulAlgorithm::kAuto);
+  void MulMatrix(const s21::BasicConstMatrixView<T> &other,
+                 s21::MulAlgorithm algorithm = s21::MulAlgorithm::kAuto);
+  S21BasicMatrix Transpose() const noexcept;
+  void TransposeInPlace();
+  S21BasicMatrix CalcComplements() const;
+  T Determinant(s21::Factorization factorization =
+                    s21::Factorization::kAuto) const;
+  // Natural logarithm of |det|, -inf for a singular matrix. Finite where
+  // the determinant itself overflows or underflows, as it does for large
+  // covariance matrices.
+  T LogDeterminant(s21::Factorization factorization =
+                       s21::Factorization::kAuto) const;
+  S21BasicMatrix InverseMatrix(
+      s21::Factorization factorization = s21::Factorization::kAuto) const;
+  // In-place this = alpha * lhs * rhs + beta * this and
+  // this += alpha * other, see MatrixView::Gemm.
+  void Gemm(T alpha, const s21::BasicConstMatrixView<T> &lhs,
+            const s21::BasicConstMatrixView<T> &rhs, T beta,
+            s21::MulAlgorithm algorithm = s21::MulAlgorithm::kAuto);
+  void Axpy(T alpha, const s21::BasicConstMatrixView<T> &other);
+
+  // Binary persistence, see s21_matrix_io.h for the format. Load reads the
+  // whole file and verifies its checksum. Map wraps the file instead: no
+  // element is read until it is touched, and the mapping lives as long as
+  // the matrix keeps its storage. Copies of a mapped matrix are ordinary
+  // matrices. Files record their element type and only load into a matrix
+  // of that type.
+  void Save(const std::string &path) const;
+  static S21BasicMatrix Load(const std::string &path);
+  static S21BasicMatrix Map(const std::string &path,
+                            s21::MapMode mode = s21::MapMode::kPrivate);
+  bool Mapped() const noexcept;
+
+  // Plain text, one row per line. Numbers are separated by whitespace or by
+  // a comma or semicolon, blank lines are skipped and the shape comes from
+  // the text itself. Large inputs are parsed in parallel, straight into the
+  // storage of the result. SaveText writes every element in its shortest
+  // form that reads back exactly, separated by delimiter, which must be one
+  // of the separators above or std::invalid_argument is thrown.
+  static S21BasicMatrix ParseText(std::string_view text);
+  static S21BasicMatrix LoadText(const std::string &path);
+  void SaveText(const std::string &path, char delimiter = ' ') const;
 
   void CreateMatrix();
   void RemoveMatrix();
-  bool SameMatrixSize(const S21Matrix &other) const noexcept;
+  bool SameMatrixSize(const S21BasicMatrix &other) const noexcept;
   bool SquareMatrix() const;
-  S21Matrix MinorMatrix(int rows, int cols) const;
-  void FillMatrix(double num) noexcept;
+  S21BasicMatrix MinorMatrix(int rows, int cols) const;
+  void FillMatrix(T num) noexcept;
   bool CheckNullptr();
 
   int GetRows() const noexcept;
@@ -36,25 +166,527 @@ class S21Matrix {
   void SetRows(int rows);
   void SetCols(int cols);
 
-  S21Matrix operator+(const S21Matrix &other);
-  S21Matrix operator-(const S21Matrix &other);
-  S21Matrix operator*(const S21Matrix &other);
-  S21Matrix operator*(const double num) noexcept;
-  S21Matrix operator+=(const S21Matrix &other);
-  S21Matrix operator-=(const S21Matrix &other);
-  S21Matrix operator*=(const S21Matrix &other);
-  S21Matrix operator*=(const double num) noexcept;
-  S21Matrix &operator=(S21Matrix &&other);
-  S21Matrix &operator=(S21Matrix &other);
-  double &operator()(int rows, int cols);
-  double &operator()(int rows, int cols) const;
-  bool operator==(const S21Matrix &other) const noexcept;
+  // Views share the storage of the matrix and are invalidated by anything
+  // that reallocates it.
+  s21::BasicConstMatrixView<T> View() const noexcept;
+  s21::BasicMatrixView<T> View() noexcept;
+  s21::BasicConstMatrixView<T> Block(int row, int col, int rows,
+                                     int cols) const;
+  s21::BasicMatrixView<T> Block(int row, int col, int rows, int cols);
+  s21::BasicConstMatrixView<T> RowView(int row) const;
+  s21::BasicMatrixView<T> RowView(int row);
+  s21::BasicConstMatrixView<T> ColView(int col) const;
+  s21::BasicMatrixView<T> ColView(int col);
+  s21::BasicConstMatrixView<T> TransposedView() const noexcept;
+  s21::BasicMatrixView<T> TransposedView() noexcept;
+
+  // Returns the product of *this and other in a new matrix, leaving both
+  // unchanged. A product cannot overwrite its operands, so a temporary left
+  // operand has no buffer to lend.
+  S21BasicMatrix operator*(const S21BasicMatrix &other) const;
+  S21BasicMatrix &operator+=(const S21BasicMatrix &other);
+  S21BasicMatrix &operator-=(const S21BasicMatrix &other);
+  S21BasicMatrix &operator*=(const S21BasicMatrix &other);
+  S21BasicMatrix &operator*=(const T num) noexcept;
+  S21BasicMatrix &operator=(S21BasicMatrix &&other);
+  // Reuses the storage of *this when the shapes match.
+  S21BasicMatrix &operator=(const S21BasicMatrix &other);
+  template <typename Expr, typename = s21::EnableIfMatrixExpr<Expr>>
+  S21BasicMatrix &operator=(const Expr &expr);
+  T &operator()(int rows, int cols);
+  T &operator()(int rows, int cols) const;
+  bool operator==(const S21BasicMatrix &other) const noexcept;
 
  private:
-  int rows_, cols_;
-  double **matrix_;
-  void CopyMatrix(const S21Matrix &other);
+  // Rows are stored back to back in one aligned buffer. Each row starts
+  // stride_ elements after the previous one, stride_ being cols_ rounded up
+  // to a whole number of cache lines.
+  static constexpr std::size_t kAlignment = s21::MatrixPool::kAlignment;
+  static constexpr int kStrideStep = kAlignment / sizeof(T);
+  // CalcComplements expands minors up to this size: it is exact for small
+  // integer matrices and cheaper than a factorization.
+  static constexpr int kMinorExpansionLimit = 4;
+
+  int rows_, cols_, stride_;
+  T *matrix_;
+  // Size of the heap buffer as allocated, which a rectangular
+  // TransposeInPlace leaves larger than rows_ * stride_ elements.
+  std::size_t bytes_ = 0;
+  // Set when matrix_ points into a mapped file rather than a heap buffer.
+  s21::FileMapping *mapping_ = nullptr;
+  void CopyMatrix(const S21BasicMatrix &other);
   void MoveMatrix();
+  T PivotTolerance() const noexcept;
+  bool CholeskyFactors(s21::Factorization factorization, T tolerance,
+                       S21BasicMatrix &factors) const;
+  T FactoredDeterminant(s21::Factorization factorization) const;
+  S21BasicMatrix MinorComplements() const;
+  T *Row(int row) const noexcept { return matrix_ + row * stride_; }
+  template <typename Expr>
+  void Evaluate(const Expr &expr) noexcept;
+
+  friend class s21::MatrixRef<T>;
+  template <typename U>
+  friend class S21BasicMatrix;
+};
+
+using S21Matrix = S21BasicMatrix<double>;
+using S21MatrixF = S21BasicMatrix<float>;
+using S21MatrixLD = S21BasicMatrix<long double>;
+
+namespace s21 {
+
+// Whether Determinant, InverseMatrix and Solve start factoring the square
+// matrix a with Cholesky under the hint, so that all of them decide alike.
+// tolerance is the pivot tolerance, which also bounds the asymmetry.
+template <typename T>
+bool TryCholesky(Factorization factorization, const S21BasicMatrix<T> &a,
+                 T tolerance);
+
+}  // namespace s21
+
+// operator+, operator- and scalar operator* build expression objects instead
+// of matrices. The whole expression is evaluated element by element in one
+// pass when it is assigned to or used to construct an S21Matrix, so
+// a + b - c * 2.0 allocates nothing beyond its destination. Operands are
+// held by reference: an expression must not outlive the full expression
+// that created it.
+namespace s21 {
+
+template <typename T>
+class MatrixRef {
+ public:
+  using Scalar = T;
+
+  explicit MatrixRef(const S21BasicMatrix<T> &matrix) noexcept
+      : rows_(matrix.rows_),
+        cols_(matrix.cols_),
+        stride_(matrix.stride_),
+        data_(matrix.matrix_) {}
+
+  int GetRows() const noexcept { return rows_; }
+  int GetCols() const noexcept { return cols_; }
+  T Coeff(int row, int col) const noexcept {
+    return data_[row * stride_ + col];
+  }
+  bool Aliases(const BasicConstMatrixView<T> &dst) const noexcept {
+    return Clobbers(dst, BasicConstMatrixView<T>(data_, rows_, cols_, stride_));
+  }
+
+ private:
+  int rows_, cols_, stride_;
+  const T *data_;
+};
+
+struct Plus {
+  template <typename T>
+  static T Apply(T lhs, T rhs) noexcept {
+    return lhs + rhs;
+  }
+};
+
+struct Minus {
+  template <typename T>
+  static T Apply(T lhs, T rhs) noexcept {
+    return lhs - rhs;
+  }
+};
+
+template <typename Op, typename Lhs, typename Rhs>
+class BinaryExpr {
+ public:
+  using Scalar = typename Lhs::Scalar;
+  static_assert(std::is_same<Scalar, typename Rhs::Scalar>::value,
+                "Operands of a matrix expression must have one element "
+                "type; convert one of them explicitly.");
+
+  BinaryExpr(const Lhs &lhs, const Rhs &rhs) : lhs_(lhs), rhs_(rhs) {
+    if (lhs.GetRows() != rhs.GetRows() || lhs.GetCols() != rhs.GetCols())
+      throw std::logic_error(
+          "Error: Matrices should be the same size of rows and columns.");
+  }
+
+  int GetRows() const noexcept { return lhs_.GetRows(); }
+  int GetCols() const noexcept { return lhs_.GetCols(); }
+  Scalar Coeff(int row, int col) const noexcept {
+    return Op::Apply(lhs_.Coeff(row, col), rhs_.Coeff(row, col));
+  }
+  bool Aliases(const BasicConstMatrixView<Scalar> &dst) const noexcept {
+    return lhs_.Aliases(dst) || rhs_.Aliases(dst);
+  }
+
+ private:
+  Lhs lhs_;
+  Rhs rhs_;
+};
+
+template <typename Expr>
+class ScaleExpr {
+ public:
+  using Scalar = typename Expr::Scalar;
+
+  ScaleExpr(const Expr &expr, Scalar num) noexcept : expr_(expr), num_(num) {}
+
+  int GetRows() const noexcept { return expr_.GetRows(); }
+  int GetCols() const noexcept { return expr_.GetCols(); }
+  Scalar Coeff(int row, int col) const noexcept {
+    return expr_.Coeff(row, col) * num_;
+  }
+  bool Aliases(const BasicConstMatrixView<Scalar> &dst) const noexcept {
+    return expr_.Aliases(dst);
+  }
+
+ private:
+  Expr expr_;
+  Scalar num_;
 };
 
+// Non-owning window on matrix storage with arbitrary row and column strides:
+// element (i, j) lives at data[i * row_stride + j * col_stride]. Blocks,
+// single rows and columns and transposes of a view are views again, so
+// none of them copies. A view is also an expression leaf and converts to
+// an S21BasicMatrix when a copy is needed.
+template <typename T>
+class BasicConstMatrixView {
+ public:
+  using Scalar = T;
+
+  BasicConstMatrixView(const S21BasicMatrix<T> &matrix) noexcept;
+  BasicConstMatrixView(const T *data, int rows, int cols, int row_stride,
+                       int col_stride = 1) noexcept
+      : rows_(rows),
+        cols_(cols),
+        row_stride_(row_stride),
+        col_stride_(col_stride),
+        data_(const_cast<T *>(data)) {}
+
+  int GetRows() const noexcept { return rows_; }
+  int GetCols() const noexcept { return cols_; }
+  int GetRowStride() const noexcept { return row_stride_; }
+  int GetColStride() const noexcept { return col_stride_; }
+  const T *Data() const noexcept { return data_; }
+  T Coeff(int row, int col) const noexcept {
+    return data_[row * row_stride_ + col * col_stride_];
+  }
+  const T &operator()(int row, int col) const;
+  // Whether evaluating this expression leaf element by element into dst
+  // could read an element dst has already overwritten.
+  bool Aliases(const BasicConstMatrixView &dst) const noexcept {
+    return Clobbers(dst, *this);
+  }
+
+  BasicConstMatrixView Block(int row, int col, int rows, int cols) const;
+  BasicConstMatrixView RowView(int row) const {
+    return Block(row, 0, 1, cols_);
+  }
+  BasicConstMatrixView ColView(int col) const {
+    return Block(0, col, rows_, 1);
+  }
+  BasicConstMatrixView Transpose() const noexcept {
+    return BasicConstMatrixView(data_, cols_, rows_, col_stride_, row_stride_);
+  }
+
+  bool SameMatrixSize(const BasicConstMatrixView &other) const noexcept {
+    return rows_ == other.rows_ && cols_ == other.cols_;
+  }
+  bool EqMatrix(const BasicConstMatrixView &other) const noexcept;
+  T Determinant(Factorization factorization = Factorization::kAuto) const;
+
+ protected:
+  void CheckBlock(int row, int col, int rows, int cols) const;
+
+  int rows_, cols_, row_stride_, col_stride_;
+  T *data_;
+};
+
+// Writable view. Assignment from another view or an expression writes
+// through to the viewed elements and requires equal shapes; it does not
+// rebind the view. A right-hand side reading the destination's storage in
+// another layout, such as its own transpose, goes through a temporary.
+template <typename T>
+class BasicMatrixView : public BasicConstMatrixView<T> {
+ public:
+  BasicMatrixView(T *data, int rows, int cols, int row_stride,
+                  int col_stride = 1) noexcept
+      : BasicConstMatrixView<T>(data, rows, cols, row_stride, col_stride) {}
+  BasicMatrixView(const BasicMatrixView &other) noexcept = default;
+
+  BasicMatrixView &operator=(const BasicMatrixView &other);
+  BasicMatrixView &operator=(const BasicConstMatrixView<T> &other);
+  template <typename Expr, typename = EnableIfMatrixExpr<Expr>>
+  BasicMatrixView &operator=(const Expr &expr);
+
+  T *Data() const noexcept { return data_; }
+  T &operator()(int row, int col) const {
+    return const_cast<T &>(BasicConstMatrixView<T>::operator()(row, col));
+  }
+
+  BasicMatrixView Block(int row, int col, int rows, int cols) const;
+  BasicMatrixView RowView(int row) const { return Block(row, 0, 1, cols_); }
+  BasicMatrixView ColView(int col) const { return Block(0, col, rows_, 1); }
+  BasicMatrixView Transpose() const noexcept {
+    return BasicMatrixView(data_, cols_, rows_, col_stride_, row_stride_);
+  }
+
+  void SumMatrix(const BasicConstMatrixView<T> &other) const;
+  void SubMatrix(const BasicConstMatrixView<T> &other) const;
+  void MulNumber(const T num) const noexcept;
+  void FillMatrix(T num) const noexcept;
+  // Overwrites the view with lhs * rhs. Strassen-Winograd needs unit column
+  // strides and otherwise falls back to the blocked kernel.
+  void AssignProduct(const BasicConstMatrixView<T> &lhs,
+                     const BasicConstMatrixView<T> &rhs,
+                     MulAlgorithm algorithm = MulAlgorithm::kAuto) const;
+  // BLAS-style updates that allocate nothing: Gemm computes
+  // this = alpha * lhs * rhs + beta * this, ignoring the old contents (NaNs
+  // included) when beta is zero, and Axpy computes this += alpha * other.
+  // Only a product whose operand overlaps the view goes through a
+  // temporary; Axpy may be given the view itself.
+  void Gemm(T alpha, const BasicConstMatrixView<T> &lhs,
+            const BasicConstMatrixView<T> &rhs, T beta,
+            MulAlgorithm algorithm = MulAlgorithm::kAuto) const;
+  void Axpy(T alpha, const BasicConstMatrixView<T> &other) const;
+
+ private:
+  using BasicConstMatrixView<T>::rows_;
+  using BasicConstMatrixView<T>::cols_;
+  using BasicConstMatrixView<T>::row_stride_;
+  using BasicConstMatrixView<T>::col_stride_;
+  using BasicConstMatrixView<T>::data_;
+
+  template <typename Expr>
+  void Assign(const Expr &expr);
+  void Rescale(T beta) const noexcept;
+};
+
+template <typename Op, typename Lhs, typename Rhs>
+struct IsMatrixExpr<BinaryExpr<Op, Lhs, Rhs>> : std::true_type {};
+
+template <typename Expr>
+struct IsMatrixExpr<ScaleExpr<Expr>> : std::true_type {};
+
+template <typename T>
+struct IsMatrixExpr<BasicConstMatrixView<T>> : std::true_type {};
+
+template <typename T>
+struct IsMatrixExpr<BasicMatrixView<T>> : std::true_type {};
+
+// Whether the address ranges spanned by two views intersect.
+template <typename T>
+bool Overlap(const BasicConstMatrixView<T> &x,
+             const BasicConstMatrixView<T> &y) noexcept {
+  if (!x.GetRows() || !x.GetCols() || !y.GetRows() || !y.GetCols())
+    return false;
+  auto end = [](const BasicConstMatrixView<T> &view) {
+    return view.Data() + (view.GetRows() - 1) * view.GetRowStride() +
+           (view.GetCols() - 1) * view.GetColStride() + 1;
+  };
+  return x.Data() < end(y) && y.Data() < end(x);
+}
+
+// Writing src into dst element by element is safe when they do not overlap,
+// or when every element is read from the very place it is written to.
+template <typename T>
+bool Clobbers(const BasicConstMatrixView<T> &dst,
+              const BasicConstMatrixView<T> &src) noexcept {
+  bool same = dst.Data() == src.Data() && dst.SameMatrixSize(src) &&
+              dst.GetRowStride() == src.GetRowStride() &&
+              dst.GetColStride() == src.GetColStride();
+  return !same && Overlap(dst, src);
+}
+
+// Matrices enter expressions as MatrixRef leaves, expressions as themselves.
+template <typename T>
+struct ExprNode {
+  using Type = T;
+  static const T &Make(const T &expr) noexcept { return expr; }
+};
+
+template <typename T>
+struct ExprNode<S21BasicMatrix<T>> {
+  using Type = MatrixRef<T>;
+  static MatrixRef<T> Make(const S21BasicMatrix<T> &matrix) noexcept {
+    return MatrixRef<T>(matrix);
+  }
+};
+
+template <typename T>
+using EnableIfOperand =
+    std::enable_if_t<IsMatrix<T>::value || IsMatrixExpr<T>::value>;
+
+// Scalar factors convert to the element type of the expression they scale.
+template <typename Expr>
+using ScalarOf = typename ExprNode<Expr>::Type::Scalar;
+
+}  // namespace s21
+
+template <typename Lhs, typename Rhs, typename = s21::EnableIfOperand<Lhs>,
+          typename = s21::EnableIfOperand<Rhs>>
+s21::BinaryExpr<s21::Plus, typename s21::ExprNode<Lhs>::Type,
+                typename s21::ExprNode<Rhs>::Type>
+operator+(const Lhs &lhs, const Rhs &rhs) {
+  return {s21::ExprNode<Lhs>::Make(lhs), s21::ExprNode<Rhs>::Make(rhs)};
+}
+
+template <typename Lhs, typename Rhs, typename = s21::EnableIfOperand<Lhs>,
+          typename = s21::EnableIfOperand<Rhs>>
+s21::BinaryExpr<s21::Minus, typename s21::ExprNode<Lhs>::Type,
+                typename s21::ExprNode<Rhs>::Type>
+operator-(const Lhs &lhs, const Rhs &rhs) {
+  return {s21::ExprNode<Lhs>::Make(lhs), s21::ExprNode<Rhs>::Make(rhs)};
+}
+
+template <typename Expr, typename = s21::EnableIfOperand<Expr>>
+s21::ScaleExpr<typename s21::ExprNode<Expr>::Type> operator*(
+    const Expr &expr, const s21::ScalarOf<Expr> num) noexcept {
+  return {s21::ExprNode<Expr>::Make(expr), num};
+}
+
+template <typename Expr, typename = s21::EnableIfOperand<Expr>>
+s21::ScaleExpr<typename s21::ExprNode<Expr>::Type> operator*(
+    const s21::ScalarOf<Expr> num, const Expr &expr) noexcept {
+  return {s21::ExprNode<Expr>::Make(expr), num};
+}
+
+// A temporary matrix operand is reused as the result: its elements are
+// overwritten in place, position by position, so chains such as
+// f() + a - b * 2.0 allocate nothing at all.
+template <typename T, typename Rhs, typename = s21::EnableIfOperand<Rhs>>
+S21BasicMatrix<T> operator+(S21BasicMatrix<T> &&lhs, const Rhs &rhs) {
+  lhs = lhs + rhs;
+  return std::move(lhs);
+}
+
+template <typename T, typename Lhs, typename = s21::EnableIfOperand<Lhs>>
+S21BasicMatrix<T> operator+(const Lhs &lhs, S21BasicMatrix<T> &&rhs) {
+  rhs = lhs + rhs;
+  return std::move(rhs);
+}
+
+template <typename T, typename Rhs, typename = s21::EnableIfOperand<Rhs>>
+S21BasicMatrix<T> operator-(S21BasicMatrix<T> &&lhs, const Rhs &rhs) {
+  lhs = lhs - rhs;
+  return std::move(lhs);
+}
+
+template <typename T, typename Lhs, typename = s21::EnableIfOperand<Lhs>>
+S21BasicMatrix<T> operator-(const Lhs &lhs, S21BasicMatrix<T> &&rhs) {
+  rhs = lhs - rhs;
+  return std::move(rhs);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator+(S21BasicMatrix<T> &&lhs, S21BasicMatrix<T> &&rhs) {
+  return std::move(lhs) + static_cast<const S21BasicMatrix<T> &>(rhs);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator-(S21BasicMatrix<T> &&lhs, S21BasicMatrix<T> &&rhs) {
+  return std::move(lhs) - static_cast<const S21BasicMatrix<T> &>(rhs);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator*(
+    S21BasicMatrix<T> &&matrix,
+    const s21::ScalarOf<S21BasicMatrix<T>> num) noexcept {
+  matrix *= num;
+  return std::move(matrix);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator*(const s21::ScalarOf<S21BasicMatrix<T>> num,
+                            S21BasicMatrix<T> &&matrix) noexcept {
+  matrix *= num;
+  return std::move(matrix);
+}
+
+template <typename T>
+template <typename Expr, typename>
+S21BasicMatrix<T>::S21BasicMatrix(const Expr &expr)
+    : rows_(expr.GetRows()),
+      cols_(expr.GetCols()),
+      stride_(0),
+      matrix_(nullptr) {
+  CreateMatrix();
+  Evaluate(expr);
+}
+
+template <typename T>
+template <typename U>
+S21BasicMatrix<T>::S21BasicMatrix(const S21BasicMatrix<U> &other)
+    : rows_(other.rows_), cols_(other.cols_), stride_(0), matrix_(nullptr) {
+  CreateMatrix();
+  for (int i = 0; i < rows_; i++)
+    std::copy(other.Row(i), other.Row(i) + cols_, Row(i));
+}
+
+// A view leaf may read the destination in another layout, as in
+// m = m.Block(...) or m = m.TransposedView(). Such an expression is
+// evaluated into a new matrix first, so the old storage stays valid while it
+// is read.
+template <typename T>
+template <typename Expr, typename>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator=(const Expr &expr) {
+  if (expr.Aliases(View())) {
+    S21BasicMatrix result(expr);
+    if (SameMatrixSize(result)) {
+      CopyMatrix(result);
+    } else {
+      *this = std::move(result);
+    }
+    return *this;
+  }
+  if (rows_ != expr.GetRows() || cols_ != expr.GetCols() || !matrix_) {
+    RemoveMatrix();
+    rows_ = expr.GetRows();
+    cols_ = expr.GetCols();
+    CreateMatrix();
+  }
+  Evaluate(expr);
+  return *this;
+}
+
+template <typename T>
+template <typename Expr, typename>
+s21::BasicMatrixView<T> &s21::BasicMatrixView<T>::operator=(const Expr &expr) {
+  Assign(expr);
+  return *this;
+}
+
+template <typename T>
+template <typename Expr>
+void s21::BasicMatrixView<T>::Assign(const Expr &expr) {
+  if (rows_ != expr.GetRows() || cols_ != expr.GetCols())
+    throw std::logic_error(
+        "Error: Matrices should be the same size of rows and columns.");
+  if (expr.Aliases(*this)) {
+    S21BasicMatrix<T> result(expr);
+    Assign(result.View());
+    return;
+  }
+  for (int i = 0; i < rows_; i++) {
+    for (int j = 0; j < cols_; j++)
+      data_[i * row_stride_ + j * col_stride_] = expr.Coeff(i, j);
+  }
+}
+
+template <typename T>
+template <typename Expr>
+void S21BasicMatrix<T>::Evaluate(const Expr &expr) noexcept {
+  for (int i = 0; i < rows_; i++) {
+    T *row = Row(i);
+    for (int j = 0; j < cols_; j++) row[j] = expr.Coeff(i, j);
+  }
+}
+
+extern template class S21BasicMatrix<float>;
+extern template class S21BasicMatrix<double>;
+extern template class S21BasicMatrix<long double>;
+extern template class s21::BasicConstMatrixView<float>;
+extern template class s21::BasicConstMatrixView<double>;
+extern template class s21::BasicConstMatrixView<long double>;
+extern template class s21::BasicMatrixView<float>;
+extern template class s21::BasicMatrixView<double>;
+extern template class s21::BasicMatrixView<long double>;
+
 #endif  // SRC_S21_MATRIX_OOP_H_
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include "s21_matrix_pool.h"
+
+#include <new>
+
+namespace s21 {
+
+namespace {
+
+thread_local MatrixPool *t_pool = nullptr;
+thread_local std::size_t t_allocations = 0;
+
+void *HeapAllocate(std::size_t bytes) {
+  return ::operator new[](bytes, std::align_val_t(MatrixPool::kAlignment));
+}
+
+void HeapRelease(void *data) noexcept {
+  ::operator delete[](data, std::align_val_t(MatrixPool::kAlignment));
+}
+
+}  // namespace
+
+MatrixPool::MatrixPool(std::size_t capacity) noexcept
+    : capacity_(capacity), cached_bytes_(0), previous_(t_pool) {
+  t_pool = this;
+}
+
+MatrixPool::~MatrixPool() {
+  Clear();
+  t_pool = previous_;
+}
+
+std::size_t MatrixPool::CachedBytes() const noexcept { return cached_bytes_; }
+
+void MatrixPool::Clear() noexcept {
+  for (auto &bucket : free_) {
+    for (void *data : bucket.second) HeapRelease(data);
+  }
+  free_.clear();
+  cached_bytes_ = 0;
+}
+
+void *MatrixPool::Allocate(std::size_t bytes) {
+  t_allocations++;
+  MatrixPool *pool = t_pool;
+  if (pool) {
+    auto bucket = pool->free_.find(bytes);
+    if (bucket != pool->free_.end() && !bucket->second.empty()) {
+      void *data = bucket->second.back();
+      bucket->second.pop_back();
+      pool->cached_bytes_ -= bytes;
+      return data;
+    }
+  }
+  return HeapAllocate(bytes);
+}
+
+void MatrixPool::Release(void *data, std::size_t bytes) noexcept {
+  MatrixPool *pool = t_pool;
+  if (pool && pool->cached_bytes_ + bytes <= pool->capacity_) {
+    try {
+      pool->free_[bytes].push_back(data);
+      pool->cached_bytes_ += bytes;
+      return;
+    } catch (...) {
+      // Out of memory for the bookkeeping: hand the buffer back instead.
+    }
+  }
+  HeapRelease(data);
+}
+
+std::size_t MatrixPool::Allocations() noexcept { return t_allocations; }
+
+}  // namespace s21
@@ -0,0 +1,51 @@
+#ifndef SRC_S21_MATRIX_POOL_H_
+#define SRC_S21_MATRIX_POOL_H_
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace s21 {
+
+// Opt-in cache of matrix buffers for the current thread. While a pool is
+// alive, buffers released on its thread are kept for reuse by the next
+// matrix of the same size created on that thread instead of going back to
+// the heap, so loops producing temporaries of repeating shapes stop calling
+// the global allocator. Cached buffers are freed in bulk when the pool is
+// destroyed. Pools nest; only the innermost one is used.
+//
+// Every buffer still comes from the global heap, so matrices created inside
+// the scope may safely outlive it.
+class MatrixPool {
+ public:
+  // Alignment in bytes of every buffer handed out.
+  static constexpr std::size_t kAlignment = 64;
+  static constexpr std::size_t kDefaultCapacity = std::size_t{256} << 20;
+
+  // Buffers released while the pool holds capacity bytes are freed at once.
+  explicit MatrixPool(std::size_t capacity = kDefaultCapacity) noexcept;
+  ~MatrixPool();
+  MatrixPool(const MatrixPool &) = delete;
+  MatrixPool &operator=(const MatrixPool &) = delete;
+
+  std::size_t CachedBytes() const noexcept;
+  void Clear() noexcept;
+
+  // Allocation entry points of S21BasicMatrix: they use the innermost pool
+  // of the calling thread, or the heap when there is none. Buffers are
+  // bucketed by size in bytes, so matrices of every element type share them.
+  static void *Allocate(std::size_t bytes);
+  static void Release(void *data, std::size_t bytes) noexcept;
+  // Number of buffers Allocate has handed out on the calling thread, cached
+  // ones included. Lets tests count the allocations of an expression.
+  static std::size_t Allocations() noexcept;
+
+ private:
+  std::unordered_map<std::size_t, std::vector<void *>> free_;
+  std::size_t capacity_, cached_bytes_;
+  MatrixPool *previous_;
+};
+
+}  // namespace s21
+
+#endif  // SRC_S21_MATRIX_POOL_H_
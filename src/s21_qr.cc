@@ -0,0 +1,171 @@
+#include "s21_qr.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "s21_simd.h"
+
+namespace s21 {
+
+namespace {
+
+// Turns the column x of rows elements, stride apart, into the Householder
+// vector v of H = I - tau v v^T with H x = beta e_1: beta replaces x[0] and
+// v without its leading one the rest. Returns tau.
+template <typename T>
+T MakeReflector(int rows, T *x, int stride) noexcept {
+  T largest = 0;
+  for (int i = 1; i < rows; i++)
+    largest = std::max(largest, std::abs(x[i * stride]));
+  if (largest == T(0)) return 0;
+  // Scaled so that the sum of squares neither overflows nor underflows.
+  T sum = 0;
+  for (int i = 1; i < rows; i++) {
+    T ratio = x[i * stride] / largest;
+    sum += ratio * ratio;
+  }
+  T alpha = x[0];
+  T beta = -std::copysign(std::hypot(alpha, largest * std::sqrt(sum)), alpha);
+  T scale = 1 / (alpha - beta);
+  for (int i = 1; i < rows; i++) x[i * stride] *= scale;
+  x[0] = beta;
+  return (beta - alpha) / beta;
+}
+
+// C -= tau v (v^T C) for the rows x cols row-major C, with v as left by
+// MakeReflector. work holds cols elements.
+template <typename T>
+void ApplyReflector(int rows, int cols, const T *v, int stride, T tau, T *c,
+                    int ldc, T *work) noexcept {
+  if (tau == T(0) || cols == 0) return;
+  std::copy(c, c + cols, work);
+  for (int i = 1; i < rows; i++)
+    simd::Axpy(cols, v[i * stride], c + i * ldc, work);
+  simd::Axpy(cols, -tau, work, c);
+  for (int i = 1; i < rows; i++)
+    simd::Axpy(cols, -tau * v[i * stride], work, c + i * ldc);
+}
+
+// Copies the Householder vectors of a panel into the explicit rows x nb
+// unit lower trapezoidal V, so that the products see plain storage.
+template <typename T>
+void ExtractPanel(int rows, int nb, const T *panel, int lda, T *v) noexcept {
+  for (int i = 0; i < rows; i++) {
+    const T *row = panel + i * lda;
+    T *out = v + i * nb;
+    for (int j = 0; j < nb; j++) out[j] = j < i ? row[j] : T(j == i);
+  }
+}
+
+// Builds T column by column: T(0:i, i) = -tau_i T(0:i, 0:i) V(:, 0:i)^T v_i.
+// work holds nb elements.
+template <typename T>
+void FormT(int rows, int nb, const T *v, const T *tau, T *t, int ldt,
+           T *work) noexcept {
+  for (int i = 0; i < nb; i++) {
+    std::fill_n(work, i, T(0));
+    for (int r = i; r < rows; r++)
+      simd::Axpy(i, v[r * nb + i], v + r * nb, work);
+    for (int j = 0; j < i; j++) {
+      const T *row_j = t + j * ldt;
+      T sum = 0;
+      for (int l = j; l < i; l++) sum += row_j[l] * work[l];
+      t[j * ldt + i] = -tau[i] * sum;
+    }
+    t[i * ldt + i] = tau[i];
+    for (int j = i + 1; j < nb; j++) t[j * ldt + i] = 0;
+  }
+}
+
+// C = (I - V T^T V^T) C if transpose is set and (I - V T V^T) C otherwise,
+// for the rows x cols row-major C. work holds nb x cols elements. The
+// products are row axpys rather than Gemm calls: W stays in cache while C is
+// streamed through twice per panel instead of twice per reflector, and the
+// axpys run at the full vector width the Gemm micro-kernel does not reach.
+template <typename T>
+void ApplyBlock(int rows, int cols, int nb, const T *v, const T *t, int ldt,
+                bool transpose, T *c, int ldc, T *work) {
+  std::fill_n(work, nb * cols, T(0));
+  for (int r = 0; r < rows; r++) {
+    for (int j = 0; j < std::min(nb, r + 1); j++)
+      simd::Axpy(cols, v[r * nb + j], c + r * ldc, work + j * cols);
+  }
+  // W = T^T W or T W, in place: each row of the result only needs rows of
+  // W that are still unchanged.
+  if (transpose) {
+    for (int i = nb - 1; i >= 0; i--) {
+      T *row_i = work + i * cols;
+      simd::Scale(cols, t[i * ldt + i], row_i);
+      for (int j = 0; j < i; j++)
+        simd::Axpy(cols, t[j * ldt + i], work + j * cols, row_i);
+    }
+  } else {
+    for (int i = 0; i < nb; i++) {
+      T *row_i = work + i * cols;
+      simd::Scale(cols, t[i * ldt + i], row_i);
+      for (int j = i + 1; j < nb; j++)
+        simd::Axpy(cols, t[i * ldt + j], work + j * cols, row_i);
+    }
+  }
+  for (int r = 0; r < rows; r++) {
+    for (int j = 0; j < std::min(nb, r + 1); j++)
+      simd::Axpy(cols, -v[r * nb + j], work + j * cols, c + r * ldc);
+  }
+}
+
+}  // namespace
+
+// Each panel is factored one reflector at a time, then applied to all the
+// columns right of it at once.
+template <typename T>
+void QrFactor(int m, int n, T *a, int lda, T *t, int ldt) {
+  std::vector<T> v, work, tau(kQrBlock);
+  for (int k = 0; k < n; k += kQrBlock) {
+    int nb = std::min(kQrBlock, n - k), rows = m - k, rest = n - k - nb;
+    T *panel = a + k * lda + k;
+    work.resize(std::max(kQrBlock, nb * rest));
+    for (int j = 0; j < nb; j++) {
+      T *column = panel + j * lda + j;
+      tau[j] = MakeReflector(rows - j, column, lda);
+      ApplyReflector(rows - j, nb - j - 1, column, lda, tau[j], column + 1,
+                     lda, work.data());
+    }
+    v.resize(static_cast<std::size_t>(rows) * nb);
+    ExtractPanel(rows, nb, panel, lda, v.data());
+    FormT(rows, nb, v.data(), tau.data(), t + k, ldt, work.data());
+    if (rest) {
+      ApplyBlock(rows, rest, nb, v.data(), t + k, ldt, true, panel + nb, lda,
+                 work.data());
+    }
+  }
+}
+
+// Q^T = ... H_2 H_1 applies the panels first to last, Q the other way.
+template <typename T>
+void QrMultiply(int m, int n, int nrhs, const T *qr, int lda, const T *t,
+                int ldt, T *b, int ldb, bool transpose) {
+  std::vector<T> v, work(static_cast<std::size_t>(kQrBlock) * nrhs);
+  int panels = (n + kQrBlock - 1) / kQrBlock;
+  for (int p = 0; p < panels; p++) {
+    int k = (transpose ? p : panels - 1 - p) * kQrBlock;
+    int nb = std::min(kQrBlock, n - k), rows = m - k;
+    v.resize(static_cast<std::size_t>(rows) * nb);
+    ExtractPanel(rows, nb, qr + k * lda + k, lda, v.data());
+    ApplyBlock(rows, nrhs, nb, v.data(), t + k, ldt, transpose, b + k * ldb,
+               ldb, work.data());
+  }
+}
+
+template void QrFactor(int, int, float *, int, float *, int);
+template void QrFactor(int, int, double *, int, double *, int);
+template void QrFactor(int, int, long double *, int, long double *, int);
+template void QrMultiply(int, int, int, const float *, int, const float *,
+                         int, float *, int, bool);
+template void QrMultiply(int, int, int, const double *, int, const double *,
+                         int, double *, int, bool);
+template void QrMultiply(int, int, int, const long double *, int,
+                         const long double *, int, long double *, int, bool);
+
+}  // namespace s21
@@ -0,0 +1,31 @@
+#ifndef SRC_S21_QR_H_
+#define SRC_S21_QR_H_
+
+namespace s21 {
+
+// Householder QR kernels on row-major matrices, instantiated for float,
+// double and long double. Reflectors are grouped in panels of kQrBlock
+// columns and applied in compact WY form, H_1 ... H_nb = I - V T V^T, so
+// that applying a panel to the trailing columns or to right-hand sides takes
+// two matrix products instead of one rank-1 update per reflector.
+constexpr int kQrBlock = 32;
+
+// Factors the m x n row-major matrix A, m >= n, in place into A = Q R. R
+// overwrites the upper triangle and the Householder vectors, whose leading
+// ones are implied, the part below the diagonal. The upper triangular T of
+// the panel starting at column k goes to columns [k, k + kQrBlock) of the
+// kQrBlock x n row-major matrix t; its diagonal holds the reflector scales,
+// zero where a column needed no reflection.
+template <typename T>
+void QrFactor(int m, int n, T *a, int lda, T *t, int ldt);
+
+// Overwrites the m x nrhs row-major matrix B with Q^T B if transpose is set
+// and with Q B otherwise, given the output of QrFactor. Q is the full m x m
+// orthogonal factor and is never formed.
+template <typename T>
+void QrMultiply(int m, int n, int nrhs, const T *qr, int lda, const T *t,
+                int ldt, T *b, int ldb, bool transpose);
+
+}  // namespace s21
+
+#endif  // SRC_S21_QR_H_
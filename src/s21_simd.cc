@@ -0,0 +1,594 @@
+#include "s21_simd.h"
+
+#include <cmath>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define S21_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace s21 {
+namespace simd {
+
+namespace {
+
+template <typename T>
+void AddScalar(int n, const T *x, T *y, int i) noexcept {
+  for (; i < n; i++) y[i] += x[i];
+}
+
+template <typename T>
+void SubScalar(int n, const T *x, T *y, int i) noexcept {
+  for (; i < n; i++) y[i] -= x[i];
+}
+
+template <typename T>
+void ScaleScalar(int n, T alpha, T *y, int i) noexcept {
+  for (; i < n; i++) y[i] *= alpha;
+}
+
+template <typename T>
+void ShiftScalar(int n, T alpha, T *y, int i) noexcept {
+  for (; i < n; i++) y[i] += alpha;
+}
+
+template <typename T>
+void AxpyScalar(int n, T alpha, const T *x, T *y, int i) noexcept {
+  for (; i < n; i++) y[i] += alpha * x[i];
+}
+
+template <typename T>
+T DotScalar(int n, const T *x, const T *y, int i, T sum) noexcept {
+  for (; i < n; i++) sum += x[i] * y[i];
+  return sum;
+}
+
+template <typename T>
+bool NearScalar(int n, const T *x, const T *y, T tolerance, int i) noexcept {
+  for (; i < n; i++) {
+    if (std::abs(x[i] - y[i]) > tolerance) return false;
+  }
+  return true;
+}
+
+// Transposes the edges of a block that are not covered by whole tiles: rows
+// from full_rows on and columns from full_cols on.
+template <typename T>
+void TransposeEdges(int rows, int cols, int full_rows, int full_cols,
+                    const T *src, int src_stride, T *dst,
+                    int dst_stride) noexcept {
+  for (int i = 0; i < rows; i++) {
+    for (int j = i < full_rows ? full_cols : 0; j < cols; j++)
+      dst[j * dst_stride + i] = src[i * src_stride + j];
+  }
+}
+
+#ifdef S21_SIMD_X86
+
+void AddSse2(int n, const double *x, double *y) noexcept {
+  int i = 0;
+  for (; i + 2 <= n; i += 2)
+    _mm_storeu_pd(y + i, _mm_add_pd(_mm_loadu_pd(y + i), _mm_loadu_pd(x + i)));
+  AddScalar(n, x, y, i);
+}
+
+void SubSse2(int n, const double *x, double *y) noexcept {
+  int i = 0;
+  for (; i + 2 <= n; i += 2)
+    _mm_storeu_pd(y + i, _mm_sub_pd(_mm_loadu_pd(y + i), _mm_loadu_pd(x + i)));
+  SubScalar(n, x, y, i);
+}
+
+void ScaleSse2(int n, double alpha, double *y) noexcept {
+  __m128d factor = _mm_set1_pd(alpha);
+  int i = 0;
+  for (; i + 2 <= n; i += 2)
+    _mm_storeu_pd(y + i, _mm_mul_pd(_mm_loadu_pd(y + i), factor));
+  ScaleScalar(n, alpha, y, i);
+}
+
+void ShiftSse2(int n, double alpha, double *y) noexcept {
+  __m128d shift = _mm_set1_pd(alpha);
+  int i = 0;
+  for (; i + 2 <= n; i += 2)
+    _mm_storeu_pd(y + i, _mm_add_pd(_mm_loadu_pd(y + i), shift));
+  ShiftScalar(n, alpha, y, i);
+}
+
+void AxpySse2(int n, double alpha, const double *x, double *y) noexcept {
+  __m128d factor = _mm_set1_pd(alpha);
+  int i = 0;
+  for (; i + 2 <= n; i += 2) {
+    __m128d product = _mm_mul_pd(_mm_loadu_pd(x + i), factor);
+    _mm_storeu_pd(y + i, _mm_add_pd(_mm_loadu_pd(y + i), product));
+  }
+  AxpyScalar(n, alpha, x, y, i);
+}
+
+double DotSse2(int n, const double *x, const double *y) noexcept {
+  __m128d sum = _mm_setzero_pd();
+  int i = 0;
+  for (; i + 2 <= n; i += 2)
+    sum = _mm_add_pd(sum, _mm_mul_pd(_mm_loadu_pd(x + i), _mm_loadu_pd(y + i)));
+  double lanes[2];
+  _mm_storeu_pd(lanes, sum);
+  return DotScalar(n, x, y, i, lanes[0] + lanes[1]);
+}
+
+bool NearSse2(int n, const double *x, const double *y,
+              double tolerance) noexcept {
+  __m128d sign = _mm_set1_pd(-0.0), bound = _mm_set1_pd(tolerance);
+  int i = 0;
+  for (; i + 2 <= n; i += 2) {
+    __m128d diff = _mm_sub_pd(_mm_loadu_pd(x + i), _mm_loadu_pd(y + i));
+    __m128d over = _mm_cmpgt_pd(_mm_andnot_pd(sign, diff), bound);
+    if (_mm_movemask_pd(over)) return false;
+  }
+  return NearScalar(n, x, y, tolerance, i);
+}
+
+__attribute__((target("avx2"))) void AddAvx2(int n, const double *x,
+                                             double *y) noexcept {
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(
+        y + i, _mm256_add_pd(_mm256_loadu_pd(y + i), _mm256_loadu_pd(x + i)));
+  }
+  AddScalar(n, x, y, i);
+}
+
+__attribute__((target("avx2"))) void SubAvx2(int n, const double *x,
+                                             double *y) noexcept {
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(
+        y + i, _mm256_sub_pd(_mm256_loadu_pd(y + i), _mm256_loadu_pd(x + i)));
+  }
+  SubScalar(n, x, y, i);
+}
+
+__attribute__((target("avx2"))) void ScaleAvx2(int n, double alpha,
+                                               double *y) noexcept {
+  __m256d factor = _mm256_set1_pd(alpha);
+  int i = 0;
+  for (; i + 4 <= n; i += 4)
+    _mm256_storeu_pd(y + i, _mm256_mul_pd(_mm256_loadu_pd(y + i), factor));
+  ScaleScalar(n, alpha, y, i);
+}
+
+__attribute__((target("avx2"))) void ShiftAvx2(int n, double alpha,
+                                               double *y) noexcept {
+  __m256d shift = _mm256_set1_pd(alpha);
+  int i = 0;
+  for (; i + 4 <= n; i += 4)
+    _mm256_storeu_pd(y + i, _mm256_add_pd(_mm256_loadu_pd(y + i), shift));
+  ShiftScalar(n, alpha, y, i);
+}
+
+__attribute__((target("avx2"))) void AxpyAvx2(int n, double alpha,
+                                              const double *x,
+                                              double *y) noexcept {
+  __m256d factor = _mm256_set1_pd(alpha);
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256d product = _mm256_mul_pd(_mm256_loadu_pd(x + i), factor);
+    _mm256_storeu_pd(y + i, _mm256_add_pd(_mm256_loadu_pd(y + i), product));
+  }
+  AxpyScalar(n, alpha, x, y, i);
+}
+
+__attribute__((target("avx2"))) double DotAvx2(int n, const double *x,
+                                               const double *y) noexcept {
+  __m256d sum = _mm256_setzero_pd();
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    sum = _mm256_add_pd(
+        sum, _mm256_mul_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i)));
+  }
+  double lanes[4];
+  _mm256_storeu_pd(lanes, sum);
+  return DotScalar(n, x, y, i, (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]));
+}
+
+__attribute__((target("avx2"))) bool NearAvx2(int n, const double *x,
+                                              const double *y,
+                                              double tolerance) noexcept {
+  __m256d sign = _mm256_set1_pd(-0.0), bound = _mm256_set1_pd(tolerance);
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256d diff =
+        _mm256_sub_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i));
+    __m256d over =
+        _mm256_cmp_pd(_mm256_andnot_pd(sign, diff), bound, _CMP_GT_OQ);
+    if (_mm256_movemask_pd(over)) return false;
+  }
+  return NearScalar(n, x, y, tolerance, i);
+}
+
+void TransposeBlockSse2(int rows, int cols, const double *src,
+                        int src_stride, double *dst, int dst_stride) noexcept {
+  int full_rows = rows / 2 * 2, full_cols = cols / 2 * 2;
+  for (int i = 0; i < full_rows; i += 2) {
+    for (int j = 0; j < full_cols; j += 2) {
+      __m128d r0 = _mm_loadu_pd(src + i * src_stride + j);
+      __m128d r1 = _mm_loadu_pd(src + (i + 1) * src_stride + j);
+      _mm_storeu_pd(dst + j * dst_stride + i, _mm_unpacklo_pd(r0, r1));
+      _mm_storeu_pd(dst + (j + 1) * dst_stride + i, _mm_unpackhi_pd(r0, r1));
+    }
+  }
+  TransposeEdges(rows, cols, full_rows, full_cols, src, src_stride, dst,
+                 dst_stride);
+}
+
+__attribute__((target("avx2"))) void TransposeBlockAvx2(
+    int rows, int cols, const double *src, int src_stride, double *dst,
+    int dst_stride) noexcept {
+  int full_rows = rows / 4 * 4, full_cols = cols / 4 * 4;
+  for (int i = 0; i < full_rows; i += 4) {
+    for (int j = 0; j < full_cols; j += 4) {
+      const double *s = src + i * src_stride + j;
+      __m256d r0 = _mm256_loadu_pd(s);
+      __m256d r1 = _mm256_loadu_pd(s + src_stride);
+      __m256d r2 = _mm256_loadu_pd(s + 2 * src_stride);
+      __m256d r3 = _mm256_loadu_pd(s + 3 * src_stride);
+      __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+      __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+      __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+      __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+      double *d = dst + j * dst_stride + i;
+      _mm256_storeu_pd(d, _mm256_permute2f128_pd(t0, t2, 0x20));
+      _mm256_storeu_pd(d + dst_stride, _mm256_permute2f128_pd(t1, t3, 0x20));
+      _mm256_storeu_pd(d + 2 * dst_stride,
+                       _mm256_permute2f128_pd(t0, t2, 0x31));
+      _mm256_storeu_pd(d + 3 * dst_stride,
+                       _mm256_permute2f128_pd(t1, t3, 0x31));
+    }
+  }
+  TransposeEdges(rows, cols, full_rows, full_cols, src, src_stride, dst,
+                 dst_stride);
+}
+
+void AddSse2(int n, const float *x, float *y) noexcept {
+  int i = 0;
+  for (; i + 4 <= n; i += 4)
+    _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_loadu_ps(x + i)));
+  AddScalar(n, x, y, i);
+}
+
+void SubSse2(int n, const float *x, float *y) noexcept {
+  int i = 0;
+  for (; i + 4 <= n; i += 4)
+    _mm_storeu_ps(y + i, _mm_sub_ps(_mm_loadu_ps(y + i), _mm_loadu_ps(x + i)));
+  SubScalar(n, x, y, i);
+}
+
+void ScaleSse2(int n, float alpha, float *y) noexcept {
+  __m128 factor = _mm_set1_ps(alpha);
+  int i = 0;
+  for (; i + 4 <= n; i += 4)
+    _mm_storeu_ps(y + i, _mm_mul_ps(_mm_loadu_ps(y + i), factor));
+  ScaleScalar(n, alpha, y, i);
+}
+
+void ShiftSse2(int n, float alpha, float *y) noexcept {
+  __m128 shift = _mm_set1_ps(alpha);
+  int i = 0;
+  for (; i + 4 <= n; i += 4)
+    _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), shift));
+  ShiftScalar(n, alpha, y, i);
+}
+
+void AxpySse2(int n, float alpha, const float *x, float *y) noexcept {
+  __m128 factor = _mm_set1_ps(alpha);
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128 product = _mm_mul_ps(_mm_loadu_ps(x + i), factor);
+    _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), product));
+  }
+  AxpyScalar(n, alpha, x, y, i);
+}
+
+float DotSse2(int n, const float *x, const float *y) noexcept {
+  __m128 sum = _mm_setzero_ps();
+  int i = 0;
+  for (; i + 4 <= n; i += 4)
+    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(x + i), _mm_loadu_ps(y + i)));
+  float lanes[4];
+  _mm_storeu_ps(lanes, sum);
+  return DotScalar(n, x, y, i, (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]));
+}
+
+bool NearSse2(int n, const float *x, const float *y,
+              float tolerance) noexcept {
+  __m128 sign = _mm_set1_ps(-0.0f), bound = _mm_set1_ps(tolerance);
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128 diff = _mm_sub_ps(_mm_loadu_ps(x + i), _mm_loadu_ps(y + i));
+    __m128 over = _mm_cmpgt_ps(_mm_andnot_ps(sign, diff), bound);
+    if (_mm_movemask_ps(over)) return false;
+  }
+  return NearScalar(n, x, y, tolerance, i);
+}
+
+__attribute__((target("avx2"))) void AddAvx2(int n, const float *x,
+                                             float *y) noexcept {
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(
+        y + i, _mm256_add_ps(_mm256_loadu_ps(y + i), _mm256_loadu_ps(x + i)));
+  }
+  AddScalar(n, x, y, i);
+}
+
+__attribute__((target("avx2"))) void SubAvx2(int n, const float *x,
+                                             float *y) noexcept {
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(
+        y + i, _mm256_sub_ps(_mm256_loadu_ps(y + i), _mm256_loadu_ps(x + i)));
+  }
+  SubScalar(n, x, y, i);
+}
+
+__attribute__((target("avx2"))) void ScaleAvx2(int n, float alpha,
+                                               float *y) noexcept {
+  __m256 factor = _mm256_set1_ps(alpha);
+  int i = 0;
+  for (; i + 8 <= n; i += 8)
+    _mm256_storeu_ps(y + i, _mm256_mul_ps(_mm256_loadu_ps(y + i), factor));
+  ScaleScalar(n, alpha, y, i);
+}
+
+__attribute__((target("avx2"))) void ShiftAvx2(int n, float alpha,
+                                               float *y) noexcept {
+  __m256 shift = _mm256_set1_ps(alpha);
+  int i = 0;
+  for (; i + 8 <= n; i += 8)
+    _mm256_storeu_ps(y + i, _mm256_add_ps(_mm256_loadu_ps(y + i), shift));
+  ShiftScalar(n, alpha, y, i);
+}
+
+__attribute__((target("avx2"))) void AxpyAvx2(int n, float alpha,
+                                              const float *x,
+                                              float *y) noexcept {
+  __m256 factor = _mm256_set1_ps(alpha);
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 product = _mm256_mul_ps(_mm256_loadu_ps(x + i), factor);
+    _mm256_storeu_ps(y + i, _mm256_add_ps(_mm256_loadu_ps(y + i), product));
+  }
+  AxpyScalar(n, alpha, x, y, i);
+}
+
+__attribute__((target("avx2"))) float DotAvx2(int n, const float *x,
+                                              const float *y) noexcept {
+  __m256 sum = _mm256_setzero_ps();
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    sum = _mm256_add_ps(
+        sum, _mm256_mul_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i)));
+  }
+  float lanes[8];
+  _mm256_storeu_ps(lanes, sum);
+  float total = 0.0f;
+  for (float lane : lanes) total += lane;
+  return DotScalar(n, x, y, i, total);
+}
+
+__attribute__((target("avx2"))) bool NearAvx2(int n, const float *x,
+                                              const float *y,
+                                              float tolerance) noexcept {
+  __m256 sign = _mm256_set1_ps(-0.0f), bound = _mm256_set1_ps(tolerance);
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 diff = _mm256_sub_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i));
+    __m256 over =
+        _mm256_cmp_ps(_mm256_andnot_ps(sign, diff), bound, _CMP_GT_OQ);
+    if (_mm256_movemask_ps(over)) return false;
+  }
+  return NearScalar(n, x, y, tolerance, i);
+}
+
+// Four rows of floats fill one SSE register each, so 4x4 tiles need no AVX.
+void TransposeBlockSse2(int rows, int cols, const float *src, int src_stride,
+                        float *dst, int dst_stride) noexcept {
+  int full_rows = rows / 4 * 4, full_cols = cols / 4 * 4;
+  for (int i = 0; i < full_rows; i += 4) {
+    for (int j = 0; j < full_cols; j += 4) {
+      const float *s = src + i * src_stride + j;
+      __m128 r0 = _mm_loadu_ps(s);
+      __m128 r1 = _mm_loadu_ps(s + src_stride);
+      __m128 r2 = _mm_loadu_ps(s + 2 * src_stride);
+      __m128 r3 = _mm_loadu_ps(s + 3 * src_stride);
+      _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+      float *d = dst + j * dst_stride + i;
+      _mm_storeu_ps(d, r0);
+      _mm_storeu_ps(d + dst_stride, r1);
+      _mm_storeu_ps(d + 2 * dst_stride, r2);
+      _mm_storeu_ps(d + 3 * dst_stride, r3);
+    }
+  }
+  TransposeEdges(rows, cols, full_rows, full_cols, src, src_stride, dst,
+                 dst_stride);
+}
+
+bool HasAvx2() noexcept {
+  static const bool has_avx2 = __builtin_cpu_supports("avx2");
+  return has_avx2;
+}
+
+#endif  // S21_SIMD_X86
+
+}  // namespace
+
+void Add(int n, const float *x, float *y) noexcept {
+#ifdef S21_SIMD_X86
+  HasAvx2() ? AddAvx2(n, x, y) : AddSse2(n, x, y);
+#else
+  AddScalar(n, x, y, 0);
+#endif
+}
+
+void Add(int n, const double *x, double *y) noexcept {
+#ifdef S21_SIMD_X86
+  HasAvx2() ? AddAvx2(n, x, y) : AddSse2(n, x, y);
+#else
+  AddScalar(n, x, y, 0);
+#endif
+}
+
+void Add(int n, const long double *x, long double *y) noexcept {
+  AddScalar(n, x, y, 0);
+}
+
+void Sub(int n, const float *x, float *y) noexcept {
+#ifdef S21_SIMD_X86
+  HasAvx2() ? SubAvx2(n, x, y) : SubSse2(n, x, y);
+#else
+  SubScalar(n, x, y, 0);
+#endif
+}
+
+void Sub(int n, const double *x, double *y) noexcept {
+#ifdef S21_SIMD_X86
+  HasAvx2() ? SubAvx2(n, x, y) : SubSse2(n, x, y);
+#else
+  SubScalar(n, x, y, 0);
+#endif
+}
+
+void Sub(int n, const long double *x, long double *y) noexcept {
+  SubScalar(n, x, y, 0);
+}
+
+void Scale(int n, float alpha, float *y) noexcept {
+#ifdef S21_SIMD_X86
+  HasAvx2() ? ScaleAvx2(n, alpha, y) : ScaleSse2(n, alpha, y);
+#else
+  ScaleScalar(n, alpha, y, 0);
+#endif
+}
+
+void Scale(int n, double alpha, double *y) noexcept {
+#ifdef S21_SIMD_X86
+  HasAvx2() ? ScaleAvx2(n, alpha, y) : ScaleSse2(n, alpha, y);
+#else
+  ScaleScalar(n, alpha, y, 0);
+#endif
+}
+
+void Scale(int n, long double alpha, long double *y) noexcept {
+  ScaleScalar(n, alpha, y, 0);
+}
+
+void Shift(int n, float alpha, float *y) noexcept {
+#ifdef S21_SIMD_X86
+  HasAvx2() ? ShiftAvx2(n, alpha, y) : ShiftSse2(n, alpha, y);
+#else
+  ShiftScalar(n, alpha, y, 0);
+#endif
+}
+
+void Shift(int n, double alpha, double *y) noexcept {
+#ifdef S21_SIMD_X86
+  HasAvx2() ? ShiftAvx2(n, alpha, y) : ShiftSse2(n, alpha, y);
+#else
+  ShiftScalar(n, alpha, y, 0);
+#endif
+}
+
+void Shift(int n, long double alpha, long double *y) noexcept {
+  ShiftScalar(n, alpha, y, 0);
+}
+
+void Axpy(int n, float alpha, const float *x, float *y) noexcept {
+#ifdef S21_SIMD_X86
+  HasAvx2() ? AxpyAvx2(n, alpha, x, y) : AxpySse2(n, alpha, x, y);
+#else
+  AxpyScalar(n, alpha, x, y, 0);
+#endif
+}
+
+void Axpy(int n, double alpha, const double *x, double *y) noexcept {
+#ifdef S21_SIMD_X86
+  HasAvx2() ? AxpyAvx2(n, alpha, x, y) : AxpySse2(n, alpha, x, y);
+#else
+  AxpyScalar(n, alpha, x, y, 0);
+#endif
+}
+
+void Axpy(int n, long double alpha, const long double *x,
+          long double *y) noexcept {
+  AxpyScalar(n, alpha, x, y, 0);
+}
+
+float Dot(int n, const float *x, const float *y) noexcept {
+#ifdef S21_SIMD_X86
+  return HasAvx2() ? DotAvx2(n, x, y) : DotSse2(n, x, y);
+#else
+  return DotScalar(n, x, y, 0, 0.0f);
+#endif
+}
+
+double Dot(int n, const double *x, const double *y) noexcept {
+#ifdef S21_SIMD_X86
+  return HasAvx2() ? DotAvx2(n, x, y) : DotSse2(n, x, y);
+#else
+  return DotScalar(n, x, y, 0, 0.0);
+#endif
+}
+
+long double Dot(int n, const long double *x, const long double *y) noexcept {
+  return DotScalar(n, x, y, 0, 0.0L);
+}
+
+bool Near(int n, const float *x, const float *y, float tolerance) noexcept {
+#ifdef S21_SIMD_X86
+  return HasAvx2() ? NearAvx2(n, x, y, tolerance)
+                   : NearSse2(n, x, y, tolerance);
+#else
+  return NearScalar(n, x, y, tolerance, 0);
+#endif
+}
+
+bool Near(int n, const double *x, const double *y, double tolerance) noexcept {
+#ifdef S21_SIMD_X86
+  return HasAvx2() ? NearAvx2(n, x, y, tolerance)
+                   : NearSse2(n, x, y, tolerance);
+#else
+  return NearScalar(n, x, y, tolerance, 0);
+#endif
+}
+
+bool Near(int n, const long double *x, const long double *y,
+          long double tolerance) noexcept {
+  return NearScalar(n, x, y, tolerance, 0);
+}
+
+void TransposeBlock(int rows, int cols, const float *src, int src_stride,
+                    float *dst, int dst_stride) noexcept {
+#ifdef S21_SIMD_X86
+  TransposeBlockSse2(rows, cols, src, src_stride, dst, dst_stride);
+#else
+  TransposeEdges(rows, cols, 0, 0, src, src_stride, dst, dst_stride);
+#endif
+}
+
+void TransposeBlock(int rows, int cols, const double *src, int src_stride,
+                    double *dst, int dst_stride) noexcept {
+#ifdef S21_SIMD_X86
+  HasAvx2() ? TransposeBlockAvx2(rows, cols, src, src_stride, dst, dst_stride)
+            : TransposeBlockSse2(rows, cols, src, src_stride, dst, dst_stride);
+#else
+  TransposeEdges(rows, cols, 0, 0, src, src_stride, dst, dst_stride);
+#endif
+}
+
+void TransposeBlock(int rows, int cols, const long double *src,
+                    int src_stride, long double *dst,
+                    int dst_stride) noexcept {
+  TransposeEdges(rows, cols, 0, 0, src, src_stride, dst, dst_stride);
+}
+
+}  // namespace simd
+}  // namespace s21
@@ -0,0 +1,57 @@
+#ifndef SRC_S21_SIMD_H_
+#define SRC_S21_SIMD_H_
+
+namespace s21 {
+namespace simd {
+
+// Vectorized kernels over n contiguous elements. On x86-64 the widest
+// instruction set supported by the running CPU (AVX2 or SSE2) is picked on
+// first use; other targets, and long double everywhere, get plain loops for
+// the compiler to vectorize. Every kernel comes in float, double and long
+// double flavours.
+
+// y += x
+void Add(int n, const float *x, float *y) noexcept;
+void Add(int n, const double *x, double *y) noexcept;
+void Add(int n, const long double *x, long double *y) noexcept;
+// y -= x
+void Sub(int n, const float *x, float *y) noexcept;
+void Sub(int n, const double *x, double *y) noexcept;
+void Sub(int n, const long double *x, long double *y) noexcept;
+// y *= alpha
+void Scale(int n, float alpha, float *y) noexcept;
+void Scale(int n, double alpha, double *y) noexcept;
+void Scale(int n, long double alpha, long double *y) noexcept;
+// y += alpha
+void Shift(int n, float alpha, float *y) noexcept;
+void Shift(int n, double alpha, double *y) noexcept;
+void Shift(int n, long double alpha, long double *y) noexcept;
+// y += alpha * x
+void Axpy(int n, float alpha, const float *x, float *y) noexcept;
+void Axpy(int n, double alpha, const double *x, double *y) noexcept;
+void Axpy(int n, long double alpha, const long double *x,
+          long double *y) noexcept;
+// Sum of x[i] * y[i]
+float Dot(int n, const float *x, const float *y) noexcept;
+double Dot(int n, const double *x, const double *y) noexcept;
+long double Dot(int n, const long double *x, const long double *y) noexcept;
+// Whether no |x[i] - y[i]| exceeds tolerance. NaN differences do not count
+// as exceeding it.
+bool Near(int n, const float *x, const float *y, float tolerance) noexcept;
+bool Near(int n, const double *x, const double *y, double tolerance) noexcept;
+bool Near(int n, const long double *x, const long double *y,
+          long double tolerance) noexcept;
+// dst(j, i) = src(i, j) for a rows x cols block, through in-register
+// transposes of 4x4 tiles (2x2 tiles of doubles without AVX2). Both buffers
+// are row-major with the given strides.
+void TransposeBlock(int rows, int cols, const float *src, int src_stride,
+                    float *dst, int dst_stride) noexcept;
+void TransposeBlock(int rows, int cols, const double *src, int src_stride,
+                    double *dst, int dst_stride) noexcept;
+void TransposeBlock(int rows, int cols, const long double *src,
+                    int src_stride, long double *dst, int dst_stride) noexcept;
+
+}  // namespace simd
+}  // namespace s21
+
+#endif  // SRC_S21_SIMD_H_
@@ -0,0 +1,476 @@
+#include "s21_solve.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "s21_lu.h"
+#include "s21_qr.h"
+
+namespace s21 {
+
+namespace {
+
+// Refinement converges linearly at a rate of about cond(A) times the float
+// epsilon. It is abandoned after kMaxRefinements steps, or as soon as a
+// step fails to halve the backward error: the float factors are then too
+// inaccurate for it to pay off.
+constexpr int kMaxRefinements = 30;
+
+void CheckSquare(int rows, int cols) {
+  if (rows != cols) throw std::length_error("Error: Matrix should be square.");
+}
+
+void CheckRightHandSide(int rows, int size) {
+  if (rows != size)
+    throw std::logic_error(
+        "Error: Right-hand side should have as many rows as the matrix.");
+}
+
+template <typename T>
+T MaxAbs(const BasicConstMatrixView<T> &a) noexcept {
+  T max_abs = 0;
+  for (int i = 0; i < a.GetRows(); i++) {
+    for (int j = 0; j < a.GetCols(); j++)
+      max_abs = std::max(max_abs, std::abs(a.Coeff(i, j)));
+  }
+  return max_abs;
+}
+
+// Largest absolute row sum.
+double NormInf(const ConstMatrixView &a) noexcept {
+  double norm = 0.0;
+  for (int i = 0; i < a.GetRows(); i++) {
+    double sum = 0.0;
+    for (int j = 0; j < a.GetCols(); j++) sum += std::abs(a.Coeff(i, j));
+    norm = std::max(norm, sum);
+  }
+  return norm;
+}
+
+// Infinity norm of every column.
+std::vector<double> ColumnNorms(const ConstMatrixView &a) {
+  std::vector<double> norms(a.GetCols());
+  for (int i = 0; i < a.GetRows(); i++) {
+    for (int j = 0; j < a.GetCols(); j++)
+      norms[j] = std::max(norms[j], std::abs(a.Coeff(i, j)));
+  }
+  return norms;
+}
+
+template <typename To, typename From>
+void Convert(const BasicConstMatrixView<From> &from, BasicMatrixView<To> to) {
+  for (int i = 0; i < from.GetRows(); i++) {
+    const From *row = from.Data() + i * from.GetRowStride();
+    std::copy(row, row + from.GetCols(), to.Data() + i * to.GetRowStride());
+  }
+}
+
+// LU factors of A in precision T; returns the sign of the permutation. Fails
+// with 0 if a pivot is lost in the rounding noise of T relative to the
+// largest element of A, max_abs.
+template <typename T, typename U>
+int Factor(const S21BasicMatrix<U> &a, U max_abs, S21BasicMatrix<T> &lu,
+           std::vector<int> &pivots) {
+  int n = a.GetRows();
+  lu = S21BasicMatrix<T>(a);
+  BasicMatrixView<T> factors = lu.View();
+  int sign = LuFactor(n, factors.Data(), factors.GetRowStride(), pivots.data());
+  U tolerance = n * U(std::numeric_limits<T>::epsilon()) * max_abs;
+  for (int k = 0; sign && k < n; k++) {
+    if (!(std::abs(static_cast<U>(factors.Coeff(k, k))) > tolerance))
+      return 0;
+  }
+  return sign;
+}
+
+// Pivots of a Cholesky factorization below this bound are rounding noise
+// of the largest element of A.
+template <typename T>
+T CholeskyTolerance(const S21BasicMatrix<T> &a) noexcept {
+  return a.GetRows() * std::numeric_limits<T>::epsilon() * MaxAbs(a.View());
+}
+
+template <typename T>
+bool CholeskyInPlace(S21BasicMatrix<T> &a, T tolerance) noexcept {
+  BasicMatrixView<T> factor = a.View();
+  return CholeskyFactor(a.GetRows(), factor.Data(), factor.GetRowStride(),
+                        tolerance);
+}
+
+template <typename T>
+void Substitute(const S21BasicMatrix<T> &lu, const std::vector<int> &pivots,
+                S21BasicMatrix<T> &b) {
+  BasicConstMatrixView<T> factors = lu.View();
+  BasicMatrixView<T> x = b.View();
+  LuSolve(x.GetRows(), x.GetCols(), factors.Data(), factors.GetRowStride(),
+          pivots.data(), x.Data(), x.GetRowStride());
+}
+
+template <typename T>
+S21BasicMatrix<T> Identity(int n) {
+  S21BasicMatrix<T> identity(n, n);
+  for (int i = 0; i < n; i++) identity(i, i) = 1;
+  return identity;
+}
+
+// Tracks the residual b - A x of a system in double precision.
+class Residual {
+ public:
+  Residual(const S21Matrix &a, const S21Matrix &b)
+      : a_(a),
+        b_(b),
+        a_norm_(NormInf(a)),
+        b_norms_(ColumnNorms(b)),
+        residual_(b.GetRows(), b.GetCols()) {}
+
+  // Recomputes the residual of x and returns its backward error.
+  double Update(const S21Matrix &x) {
+    residual_ = b_;
+    residual_.Gemm(-1.0, a_, x, 1.0);
+    residual_norms_ = ColumnNorms(residual_);
+    x_norms_ = ColumnNorms(x);
+    double error = 0.0;
+    for (std::size_t j = 0; j < x_norms_.size(); j++) {
+      double scale = a_norm_ * x_norms_[j] + b_norms_[j];
+      if (residual_norms_[j] > 0.0)
+        error = std::max(error, residual_norms_[j] / scale);
+    }
+    return error;
+  }
+
+  // The stopping test of LAPACK's dsgesv: every column of the residual is
+  // below what rounding A x to double precision can explain.
+  bool Converged() const noexcept {
+    double bound = a_norm_ * std::numeric_limits<double>::epsilon() *
+                   std::sqrt(static_cast<double>(a_.GetRows()));
+    for (std::size_t j = 0; j < x_norms_.size(); j++) {
+      if (!(residual_norms_[j] <= x_norms_[j] * bound)) return false;
+    }
+    return true;
+  }
+
+  const S21Matrix &Get() const noexcept { return residual_; }
+
+ private:
+  const S21Matrix &a_, &b_;
+  double a_norm_;
+  std::vector<double> b_norms_, residual_norms_, x_norms_;
+  S21Matrix residual_;
+};
+
+// x += correction, widening the correction to double.
+void AddCorrection(const S21MatrixF &correction, S21Matrix &x) noexcept {
+  MatrixView to = x.View();
+  BasicConstMatrixView<float> step = correction.View();
+  for (int i = 0; i < to.GetRows(); i++) {
+    double *row = to.Data() + i * to.GetRowStride();
+    for (int j = 0; j < to.GetCols(); j++) row[j] += step.Coeff(i, j);
+  }
+}
+
+// Solves in float and refines x in place; false if refinement gives up.
+bool Refine(const S21Matrix &a, const S21Matrix &b, double max_abs,
+            S21Matrix &x, RefinementReport &report) {
+  int n = a.GetRows();
+  S21MatrixF lu;
+  std::vector<int> pivots(n);
+  if (!Factor(a, max_abs, lu, pivots)) return false;
+  S21MatrixF correction(b);
+  Substitute(lu, pivots, correction);
+  x = S21Matrix(correction);
+
+  Residual residual(a, b);
+  double previous = std::numeric_limits<double>::infinity();
+  for (int step = 0;; step++) {
+    double error = residual.Update(x);
+    report.iterations = step;
+    if (residual.Converged()) {
+      report.residual = error;
+      report.refined = true;
+      return true;
+    }
+    if (step == kMaxRefinements || !(error < previous / 2)) return false;
+    previous = error;
+    Convert<float, double>(residual.Get().View(), correction.View());
+    Substitute(lu, pivots, correction);
+    AddCorrection(correction, x);
+  }
+}
+
+}  // namespace
+
+S21Matrix MixedSolve(const S21Matrix &a, const S21Matrix &b,
+                     RefinementReport *report) {
+  CheckSquare(a.GetRows(), a.GetCols());
+  CheckRightHandSide(b.GetRows(), a.GetRows());
+  if (!a.GetRows()) return b;
+  RefinementReport outcome;
+  S21Matrix x;
+  double max_abs = MaxAbs(a.View());
+  if (max_abs < std::numeric_limits<float>::max() &&
+      Refine(a, b, max_abs, x, outcome)) {
+    if (report) *report = outcome;
+    return x;
+  }
+  S21Matrix lu;
+  std::vector<int> pivots(a.GetRows());
+  if (!Factor(a, max_abs, lu, pivots))
+    throw std::logic_error("Error: Matrix is not square or determinant is 0.");
+  x = b;
+  Substitute(lu, pivots, x);
+  if (report) {
+    *report = outcome;
+    report->residual = Residual(a, b).Update(x);
+    report->refined = false;
+  }
+  return x;
+}
+
+S21Matrix MixedInverse(const S21Matrix &a, RefinementReport *report) {
+  CheckSquare(a.GetRows(), a.GetCols());
+  if (!a.GetRows()) return S21Matrix();
+  return MixedSolve(a, Identity<double>(a.GetRows()), report);
+}
+
+template <typename T>
+BasicLuFactorization<T>::BasicLuFactorization() noexcept : sign_(1) {}
+
+template <typename T>
+BasicLuFactorization<T>::BasicLuFactorization(const S21BasicMatrix<T> &a)
+    : pivots_(a.GetRows()) {
+  CheckSquare(a.GetRows(), a.GetCols());
+  sign_ = a.GetRows() ? Factor(a, MaxAbs(a.View()), lu_, pivots_) : 1;
+  if (!sign_)
+    throw std::logic_error("Error: Matrix is not square or determinant is 0.");
+}
+
+template <typename T>
+S21BasicMatrix<T> BasicLuFactorization<T>::Solve(
+    const S21BasicMatrix<T> &b) const {
+  S21BasicMatrix<T> x(b);
+  SolveInPlace(x.View());
+  return x;
+}
+
+template <typename T>
+void BasicLuFactorization<T>::SolveInPlace(BasicMatrixView<T> b) const {
+  CheckRightHandSide(b.GetRows(), GetSize());
+  if (!b.GetRows() || !b.GetCols()) return;
+  BasicConstMatrixView<T> factors = lu_.View();
+  if (b.GetColStride() == 1) {
+    LuSolve(GetSize(), b.GetCols(), factors.Data(), factors.GetRowStride(),
+            pivots_.data(), b.Data(), b.GetRowStride());
+    return;
+  }
+  // Substitution needs contiguous rows of B.
+  S21BasicMatrix<T> x(b);
+  SolveInPlace(x.View());
+  b = x.View();
+}
+
+template <typename T>
+T BasicLuFactorization<T>::Determinant() const noexcept {
+  T determinant = sign_;
+  BasicConstMatrixView<T> factors = lu_.View();
+  for (int k = 0; k < GetSize(); k++) determinant *= factors.Coeff(k, k);
+  return determinant;
+}
+
+template <typename T>
+T BasicLuFactorization<T>::LogDeterminant() const noexcept {
+  T log_determinant = 0;
+  BasicConstMatrixView<T> factors = lu_.View();
+  for (int k = 0; k < GetSize(); k++)
+    log_determinant += std::log(std::abs(factors.Coeff(k, k)));
+  return log_determinant;
+}
+
+template <typename T>
+S21BasicMatrix<T> BasicLuFactorization<T>::Inverse() const {
+  if (!GetSize()) return S21BasicMatrix<T>();
+  S21BasicMatrix<T> inverse = Identity<T>(GetSize());
+  SolveInPlace(inverse.View());
+  return inverse;
+}
+
+template <typename T>
+BasicCholeskyFactorization<T>::BasicCholeskyFactorization(
+    const S21BasicMatrix<T> &a)
+    : l_(a) {
+  CheckSquare(a.GetRows(), a.GetCols());
+  if (!CholeskyInPlace(l_, CholeskyTolerance(a)))
+    throw std::logic_error("Error: Matrix is not positive definite.");
+}
+
+template <typename T>
+S21BasicMatrix<T> BasicCholeskyFactorization<T>::Solve(
+    const S21BasicMatrix<T> &b) const {
+  S21BasicMatrix<T> x(b);
+  SolveInPlace(x.View());
+  return x;
+}
+
+template <typename T>
+void BasicCholeskyFactorization<T>::SolveInPlace(BasicMatrixView<T> b) const {
+  CheckRightHandSide(b.GetRows(), GetSize());
+  if (!b.GetRows() || !b.GetCols()) return;
+  BasicConstMatrixView<T> factor = l_.View();
+  if (b.GetColStride() == 1) {
+    CholeskySolve(GetSize(), b.GetCols(), factor.Data(),
+                  factor.GetRowStride(), b.Data(), b.GetRowStride());
+    return;
+  }
+  S21BasicMatrix<T> x(b);
+  SolveInPlace(x.View());
+  b = x.View();
+}
+
+template <typename T>
+T BasicCholeskyFactorization<T>::Determinant() const noexcept {
+  T root = 1;
+  BasicConstMatrixView<T> factor = l_.View();
+  for (int k = 0; k < GetSize(); k++) root *= factor.Coeff(k, k);
+  return root * root;
+}
+
+template <typename T>
+T BasicCholeskyFactorization<T>::LogDeterminant() const noexcept {
+  T log_root = 0;
+  BasicConstMatrixView<T> factor = l_.View();
+  for (int k = 0; k < GetSize(); k++) log_root += std::log(factor.Coeff(k, k));
+  return 2 * log_root;
+}
+
+template <typename T>
+S21BasicMatrix<T> BasicCholeskyFactorization<T>::Inverse() const {
+  if (!GetSize()) return S21BasicMatrix<T>();
+  S21BasicMatrix<T> factor(l_), inverse(GetSize(), GetSize());
+  BasicMatrixView<T> l = factor.View(), result = inverse.View();
+  CholeskyInvert(GetSize(), l.Data(), l.GetRowStride(), result.Data(),
+                 result.GetRowStride());
+  return inverse;
+}
+
+template <typename T>
+BasicQrFactorization<T>::BasicQrFactorization(const S21BasicMatrix<T> &a)
+    : qr_(a) {
+  if (a.GetCols() > a.GetRows())
+    throw std::length_error(
+        "Error: Matrix should not have more columns than rows.");
+  if (!a.GetCols()) return;
+  t_ = S21BasicMatrix<T>(kQrBlock, a.GetCols());
+  BasicMatrixView<T> factors = qr_.View(), t = t_.View();
+  QrFactor(GetRows(), GetCols(), factors.Data(), factors.GetRowStride(),
+           t.Data(), t.GetRowStride());
+  tolerance_ = GetRows() * std::numeric_limits<T>::epsilon() * MaxAbs(a.View());
+}
+
+template <typename T>
+S21BasicMatrix<T> BasicQrFactorization<T>::Solve(
+    const S21BasicMatrix<T> &b) const {
+  CheckRightHandSide(b.GetRows(), GetRows());
+  BasicConstMatrixView<T> factors = qr_.View();
+  for (int k = 0; k < GetCols(); k++) {
+    if (!(std::abs(factors.Coeff(k, k)) > tolerance_))
+      throw std::logic_error("Error: Matrix does not have full column rank.");
+  }
+  if (!GetCols()) return S21BasicMatrix<T>();
+  S21BasicMatrix<T> c(b);
+  MultiplyQTranspose(c.View());
+  S21BasicMatrix<T> x = c.View().Block(0, 0, GetCols(), c.GetCols());
+  BasicMatrixView<T> solution = x.View();
+  UpperSolve(GetCols(), x.GetCols(), factors.Data(), factors.GetRowStride(),
+             solution.Data(), solution.GetRowStride());
+  return x;
+}
+
+template <typename T>
+void BasicQrFactorization<T>::MultiplyQ(BasicMatrixView<T> b) const {
+  Multiply(b, false);
+}
+
+template <typename T>
+void BasicQrFactorization<T>::MultiplyQTranspose(BasicMatrixView<T> b) const {
+  Multiply(b, true);
+}
+
+template <typename T>
+void BasicQrFactorization<T>::Multiply(BasicMatrixView<T> b,
+                                       bool transpose) const {
+  CheckRightHandSide(b.GetRows(), GetRows());
+  if (!GetCols() || !b.GetCols()) return;
+  if (b.GetColStride() != 1) {
+    S21BasicMatrix<T> copy(b);
+    Multiply(copy.View(), transpose);
+    b = copy.View();
+    return;
+  }
+  BasicConstMatrixView<T> factors = qr_.View(), t = t_.View();
+  QrMultiply(GetRows(), GetCols(), b.GetCols(), factors.Data(),
+             factors.GetRowStride(), t.Data(), t.GetRowStride(), b.Data(),
+             b.GetRowStride(), transpose);
+}
+
+template <typename T>
+S21BasicMatrix<T> BasicQrFactorization<T>::GetR() const {
+  if (!GetCols()) return S21BasicMatrix<T>();
+  S21BasicMatrix<T> r(GetCols(), GetCols());
+  BasicConstMatrixView<T> factors = qr_.View();
+  for (int i = 0; i < GetCols(); i++) {
+    for (int j = i; j < GetCols(); j++) r(i, j) = factors.Coeff(i, j);
+  }
+  return r;
+}
+
+template <typename T>
+S21BasicMatrix<T> BasicQrFactorization<T>::FormQ() const {
+  if (!GetCols()) return S21BasicMatrix<T>();
+  S21BasicMatrix<T> q(GetRows(), GetCols());
+  for (int i = 0; i < GetCols(); i++) q(i, i) = 1;
+  MultiplyQ(q.View());
+  return q;
+}
+
+template <typename T>
+S21BasicMatrix<T> Solve(const S21BasicMatrix<T> &a, const S21BasicMatrix<T> &b,
+                        Factorization factorization) {
+  if (a.GetRows() > a.GetCols()) return BasicQrFactorization<T>(a).Solve(b);
+  CheckSquare(a.GetRows(), a.GetCols());
+  CheckRightHandSide(b.GetRows(), a.GetRows());
+  T tolerance = CholeskyTolerance(a);
+  if (TryCholesky(factorization, a, tolerance)) {
+    S21BasicMatrix<T> l(a);
+    if (CholeskyInPlace(l, tolerance)) {
+      S21BasicMatrix<T> x(b);
+      BasicConstMatrixView<T> factor = l.View();
+      BasicMatrixView<T> solution = x.View();
+      CholeskySolve(a.GetRows(), b.GetCols(), factor.Data(),
+                    factor.GetRowStride(), solution.Data(),
+                    solution.GetRowStride());
+      return x;
+    }
+    if (factorization == Factorization::kCholesky)
+      throw std::logic_error("Error: Matrix is not positive definite.");
+  }
+  return BasicLuFactorization<T>(a).Solve(b);
+}
+
+template class BasicLuFactorization<float>;
+template class BasicLuFactorization<double>;
+template class BasicLuFactorization<long double>;
+template class BasicCholeskyFactorization<float>;
+template class BasicCholeskyFactorization<double>;
+template class BasicCholeskyFactorization<long double>;
+template class BasicQrFactorization<float>;
+template class BasicQrFactorization<double>;
+template class BasicQrFactorization<long double>;
+template S21MatrixF Solve(const S21MatrixF &, const S21MatrixF &,
+                          Factorization);
+template S21Matrix Solve(const S21Matrix &, const S21Matrix &, Factorization);
+template S21MatrixLD Solve(const S21MatrixLD &, const S21MatrixLD &,
+                           Factorization);
+
+}  // namespace s21
@@ -0,0 +1,154 @@
+#ifndef SRC_S21_SOLVE_H_
+#define SRC_S21_SOLVE_H_
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+namespace s21 {
+
+// LU factorization with partial pivoting of a square matrix, computed once
+// and applied to any number of right-hand sides. Solving a block of them
+// at once vectorizes across the block, so gathering right-hand sides into
+// the columns of one matrix beats solving them one by one. Throws like
+// InverseMatrix for singular or non-square matrices; a pivot counts as zero
+// when it is lost in the rounding noise of the largest element.
+template <typename T>
+class BasicLuFactorization {
+ public:
+  BasicLuFactorization() noexcept;
+  explicit BasicLuFactorization(const S21BasicMatrix<T> &a);
+
+  int GetSize() const noexcept { return lu_.GetRows(); }
+
+  // X with A X = B. B needs GetSize() rows, or std::logic_error is thrown.
+  S21BasicMatrix<T> Solve(const S21BasicMatrix<T> &b) const;
+  // Overwrites B with X without allocating, unless the columns of B are
+  // not contiguous.
+  void SolveInPlace(BasicMatrixView<T> b) const;
+  T Determinant() const noexcept;
+  // Natural logarithm of |det|.
+  T LogDeterminant() const noexcept;
+  S21BasicMatrix<T> Inverse() const;
+
+ private:
+  S21BasicMatrix<T> lu_;
+  std::vector<int> pivots_;
+  int sign_;
+};
+
+using LuFactorization = BasicLuFactorization<double>;
+
+extern template class BasicLuFactorization<float>;
+extern template class BasicLuFactorization<double>;
+extern template class BasicLuFactorization<long double>;
+
+// Cholesky factorization A = L L^T of a symmetric positive definite matrix,
+// such as a covariance matrix: half the work of LU and no pivoting. Only
+// the lower triangle of A is read. Throws std::length_error for non-square
+// matrices and std::logic_error if A is not positive definite, or too close
+// to singular to tell.
+template <typename T>
+class BasicCholeskyFactorization {
+ public:
+  BasicCholeskyFactorization() noexcept = default;
+  explicit BasicCholeskyFactorization(const S21BasicMatrix<T> &a);
+
+  int GetSize() const noexcept { return l_.GetRows(); }
+
+  // See BasicLuFactorization.
+  S21BasicMatrix<T> Solve(const S21BasicMatrix<T> &b) const;
+  void SolveInPlace(BasicMatrixView<T> b) const;
+  T Determinant() const noexcept;
+  // Natural logarithm of det, finite where det itself overflows.
+  T LogDeterminant() const noexcept;
+  S21BasicMatrix<T> Inverse() const;
+
+ private:
+  S21BasicMatrix<T> l_;
+};
+
+using CholeskyFactorization = BasicCholeskyFactorization<double>;
+
+extern template class BasicCholeskyFactorization<float>;
+extern template class BasicCholeskyFactorization<double>;
+extern template class BasicCholeskyFactorization<long double>;
+
+// Householder QR factorization A = Q R of an m x n matrix with m >= n, for
+// least-squares problems. Q stays implicit as the Householder vectors left
+// in the factored matrix: MultiplyQ and MultiplyQTranspose apply the full
+// m x m Q in place, and FormQ builds its first n columns only on request.
+// Throws std::length_error if A has more columns than rows.
+template <typename T>
+class BasicQrFactorization {
+ public:
+  BasicQrFactorization() noexcept = default;
+  explicit BasicQrFactorization(const S21BasicMatrix<T> &a);
+
+  int GetRows() const noexcept { return qr_.GetRows(); }
+  int GetCols() const noexcept { return qr_.GetCols(); }
+
+  // The n x nrhs X minimizing the 2-norm of every column of A X - B, for an
+  // m x nrhs B. Throws std::logic_error if B does not have m rows or A does
+  // not have full column rank.
+  S21BasicMatrix<T> Solve(const S21BasicMatrix<T> &b) const;
+  // B = Q B and B = Q^T B for m-row B.
+  void MultiplyQ(BasicMatrixView<T> b) const;
+  void MultiplyQTranspose(BasicMatrixView<T> b) const;
+  // The n x n upper triangular R and the m x n Q with orthonormal columns.
+  S21BasicMatrix<T> GetR() const;
+  S21BasicMatrix<T> FormQ() const;
+
+ private:
+  void Multiply(BasicMatrixView<T> b, bool transpose) const;
+
+  S21BasicMatrix<T> qr_, t_;
+  T tolerance_ = 0;
+};
+
+using QrFactorization = BasicQrFactorization<double>;
+
+extern template class BasicQrFactorization<float>;
+extern template class BasicQrFactorization<double>;
+extern template class BasicQrFactorization<long double>;
+
+// X with A X = B, through a one-off factorization chosen as for
+// InverseMatrix: faster and more accurate than multiplying by the inverse.
+// A tall A gives the least-squares solution through QR whatever the hint.
+// Keep a factorization object to solve against the same matrix again.
+template <typename T>
+S21BasicMatrix<T> Solve(const S21BasicMatrix<T> &a, const S21BasicMatrix<T> &b,
+                        Factorization factorization = Factorization::kAuto);
+
+// How a mixed-precision solve ended. residual is the normwise backward
+// error of the returned solution, the largest
+// ||b - A x|| / (||A|| ||x|| + ||b||) over its columns in the infinity norm.
+struct RefinementReport {
+  double residual = 0.0;
+  // Refinement steps taken on top of the float solution.
+  int iterations = 0;
+  // False when refinement did not converge and the result was recomputed
+  // from a double factorization.
+  bool refined = false;
+};
+
+// Solve A X = B and invert A with mixed precision: A is factored in float,
+// at twice the SIMD width and half the memory traffic of double, and the
+// float solution is refined with residuals computed in double until it is
+// accurate to double precision. Matrices too ill-conditioned for a float
+// factorization, or with elements outside the float range, fall back to a
+// double factorization; either way the result has double accuracy. Throws
+// like InverseMatrix for singular or non-square A, and std::logic_error if
+// B does not have as many rows as A.
+//
+// Each refinement step costs a double product A X. For a few right-hand
+// sides that is negligible next to the factorization, but MixedInverse
+// refines n of them and only beats InverseMatrix where matrix products run
+// much faster than factorizations, as on many cores.
+S21Matrix MixedSolve(const S21Matrix &a, const S21Matrix &b,
+                     RefinementReport *report = nullptr);
+S21Matrix MixedInverse(const S21Matrix &a, RefinementReport *report = nullptr);
+
+}  // namespace s21
+
+#endif  // SRC_S21_SOLVE_H_
@@ -0,0 +1,357 @@
+#include "s21_sparse_matrix.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "s21_thread_pool.h"
+
+namespace {
+
+// Products with fewer multiply-adds than this run on the calling thread.
+constexpr double kParallelWork = 1 << 16;
+
+// Calls task(begin, end) over pieces of [0, count), in parallel when work
+// multiply-adds are worth it.
+template <typename Task>
+void ForRanges(int count, double work, const Task &task) {
+  s21::ThreadPool &pool = s21::ThreadPool::Instance();
+  int pieces = std::min(count, pool.GetThreadCount() * 4);
+  if (work < kParallelWork || pieces <= 1) {
+    task(0, count);
+    return;
+  }
+  pool.ParallelFor(pieces, [&task, count, pieces](int piece) {
+    task(static_cast<long>(count) * piece / pieces,
+         static_cast<long>(count) * (piece + 1) / pieces);
+  });
+}
+
+}  // namespace
+
+S21SparseMatrix::S21SparseMatrix() noexcept
+    : rows_(0), cols_(0), format_(s21::SparseFormat::kCsr), offsets_(1, 0) {}
+
+S21SparseMatrix::S21SparseMatrix(int rows, int cols, s21::SparseFormat format)
+    : rows_(rows), cols_(cols), format_(format) {
+  if (rows <= 0 || cols <= 0)
+    throw std::invalid_argument("Invalid parameter for rows or cols.");
+  offsets_.assign(Major() + 1, 0);
+}
+
+S21SparseMatrix::S21SparseMatrix(int rows, int cols,
+                                 const std::vector<s21::Triplet> &entries,
+                                 s21::SparseFormat format)
+    : S21SparseMatrix(rows, cols, format) {
+  bool csr = format == s21::SparseFormat::kCsr;
+  for (const s21::Triplet &entry : entries) {
+    if (entry.row < 0 || entry.row >= rows || entry.col < 0 ||
+        entry.col >= cols)
+      throw std::range_error("Error: You try to put value out of matrix.");
+    offsets_[(csr ? entry.row : entry.col) + 1]++;
+  }
+  for (int k = 0; k < Major(); k++) offsets_[k + 1] += offsets_[k];
+  std::vector<std::pair<int, double>> sorted(entries.size());
+  std::vector<int> next(offsets_.begin(), offsets_.end() - 1);
+  for (const s21::Triplet &entry : entries) {
+    int major = csr ? entry.row : entry.col;
+    sorted[next[major]++] = {csr ? entry.col : entry.row, entry.value};
+  }
+  for (int k = 0; k < Major(); k++) {
+    auto begin = sorted.begin() + offsets_[k];
+    auto end = sorted.begin() + offsets_[k + 1];
+    std::sort(begin, end, [](const auto &lhs, const auto &rhs) {
+      return lhs.first < rhs.first;
+    });
+    offsets_[k] = indices_.size();
+    for (auto it = begin; it != end;) {
+      int index = it->first;
+      double sum = 0;
+      for (; it != end && it->first == index; ++it) sum += it->second;
+      if (sum != 0) {
+        indices_.push_back(index);
+        values_.push_back(sum);
+      }
+    }
+  }
+  offsets_[Major()] = indices_.size();
+}
+
+S21SparseMatrix::S21SparseMatrix(const S21Matrix &dense, double threshold,
+                                 s21::SparseFormat format)
+    : S21SparseMatrix() {
+  if (!dense.GetRows()) {
+    format_ = format;
+    return;
+  }
+  s21::ConstMatrixView view = dense.View();
+  rows_ = view.GetRows();
+  cols_ = view.GetCols();
+  offsets_.assign(rows_ + 1, 0);
+  for (int i = 0; i < rows_; i++) {
+    const double *row = view.Data() + i * view.GetRowStride();
+    for (int j = 0; j < cols_; j++) {
+      if (row[j] != 0 && !(std::fabs(row[j]) <= threshold)) {
+        indices_.push_back(j);
+        values_.push_back(row[j]);
+      }
+    }
+    offsets_[i + 1] = indices_.size();
+  }
+  if (format != format_) *this = Convert(format);
+}
+
+double S21SparseMatrix::operator()(int row, int col) const {
+  if (row < 0 || row >= rows_ || col < 0 || col >= cols_)
+    throw std::range_error("Error: You try to put value out of matrix.");
+  bool csr = format_ == s21::SparseFormat::kCsr;
+  int major = csr ? row : col, minor = csr ? col : row;
+  auto begin = indices_.begin() + offsets_[major];
+  auto end = indices_.begin() + offsets_[major + 1];
+  auto it = std::lower_bound(begin, end, minor);
+  return it != end && *it == minor ? values_[it - indices_.begin()] : 0.0;
+}
+
+S21Matrix S21SparseMatrix::ToDense() const {
+  if (!rows_) return S21Matrix();
+  S21Matrix result(rows_, cols_);
+  s21::MatrixView view = result.View();
+  int major_stride = view.GetRowStride(), minor_stride = 1;
+  if (format_ == s21::SparseFormat::kCsc) std::swap(major_stride, minor_stride);
+  for (int k = 0; k < Major(); k++) {
+    for (int p = offsets_[k]; p < offsets_[k + 1]; p++)
+      view.Data()[k * major_stride + indices_[p] * minor_stride] = values_[p];
+  }
+  return result;
+}
+
+S21SparseMatrix S21SparseMatrix::Convert(s21::SparseFormat format) const {
+  if (format == format_) return *this;
+  S21SparseMatrix result = Flipped();
+  result.format_ = format;
+  return result;
+}
+
+void S21SparseMatrix::SumMatrix(const S21SparseMatrix &other) {
+  if (rows_ != other.rows_ || cols_ != other.cols_)
+    throw std::logic_error("Error: You can't sum matrices of different size");
+  Merge(other, 1);
+}
+
+void S21SparseMatrix::SubMatrix(const S21SparseMatrix &other) {
+  if (rows_ != other.rows_ || cols_ != other.cols_)
+    throw std::logic_error("Error: You can't sub matrices of different size");
+  Merge(other, -1);
+}
+
+// Products that underflow to zero, all of them when num is zero, are
+// dropped while the storage is compacted in place.
+void S21SparseMatrix::MulNumber(const double num) noexcept {
+  int kept = 0;
+  for (int k = 0; k < Major(); k++) {
+    int begin = offsets_[k];
+    offsets_[k] = kept;
+    for (int p = begin; p < offsets_[k + 1]; p++) {
+      double value = values_[p] * num;
+      if (value != 0) {
+        indices_[kept] = indices_[p];
+        values_[kept++] = value;
+      }
+    }
+  }
+  offsets_[Major()] = kept;
+  indices_.resize(kept);
+  values_.resize(kept);
+}
+
+// CSC storage of a matrix is the CSR storage of its transpose, and
+// (A * B)^T = B^T * A^T, so the CSC product multiplies the operands'
+// storage in reverse order.
+void S21SparseMatrix::MulMatrix(const S21SparseMatrix &other) {
+  if (cols_ != other.rows_)
+    throw std::logic_error(
+        "Error: Rows of first matrix should be equal with columns of second "
+        "matrix.");
+  S21SparseMatrix converted;
+  const S21SparseMatrix *rhs = &other;
+  if (other.format_ != format_) {
+    converted = other.Convert(format_);
+    rhs = &converted;
+  }
+  S21SparseMatrix result;
+  result.rows_ = rows_;
+  result.cols_ = rhs->cols_;
+  result.format_ = format_;
+  if (format_ == s21::SparseFormat::kCsr) {
+    Multiply(*this, *rhs, result);
+  } else {
+    Multiply(*rhs, *this, result);
+  }
+  *this = std::move(result);
+}
+
+S21SparseMatrix S21SparseMatrix::Transpose() const {
+  S21SparseMatrix result = Flipped();
+  std::swap(result.rows_, result.cols_);
+  return result;
+}
+
+S21Matrix S21SparseMatrix::MulDense(const S21Matrix &other) const {
+  if (cols_ != other.GetRows())
+    throw std::logic_error(
+        "Error: Rows of first matrix should be equal with columns of second "
+        "matrix.");
+  if (format_ == s21::SparseFormat::kCsc)
+    return Convert(s21::SparseFormat::kCsr).MulDense(other);
+  S21Matrix result(rows_, other.GetCols());
+  s21::ConstMatrixView rhs = other.View();
+  s21::MatrixView out = result.View();
+  int n = rhs.GetCols();
+  ForRanges(rows_, static_cast<double>(NonZeros()) * n,
+            [this, &rhs, &out, n](int begin, int end) {
+              for (int i = begin; i < end; i++) {
+                double *row = out.Data() + i * out.GetRowStride();
+                for (int p = offsets_[i]; p < offsets_[i + 1]; p++) {
+                  const double *source =
+                      rhs.Data() + indices_[p] * rhs.GetRowStride();
+                  double value = values_[p];
+                  for (int j = 0; j < n; j++) row[j] += value * source[j];
+                }
+              }
+            });
+  return result;
+}
+
+std::vector<double> S21SparseMatrix::MulVector(
+    const std::vector<double> &vector) const {
+  if (vector.size() != static_cast<std::size_t>(cols_))
+    throw std::logic_error(
+        "Error: Vector size should be equal with columns of matrix.");
+  std::vector<double> result(rows_, 0.0);
+  if (format_ == s21::SparseFormat::kCsc) {
+    for (int j = 0; j < cols_; j++) {
+      for (int p = offsets_[j]; p < offsets_[j + 1]; p++)
+        result[indices_[p]] += values_[p] * vector[j];
+    }
+    return result;
+  }
+  ForRanges(rows_, NonZeros(), [this, &vector, &result](int begin, int end) {
+    for (int i = begin; i < end; i++) {
+      double sum = 0;
+      for (int p = offsets_[i]; p < offsets_[i + 1]; p++)
+        sum += values_[p] * vector[indices_[p]];
+      result[i] = sum;
+    }
+  });
+  return result;
+}
+
+int S21SparseMatrix::Major() const noexcept {
+  return format_ == s21::SparseFormat::kCsr ? rows_ : cols_;
+}
+
+int S21SparseMatrix::Minor() const noexcept {
+  return format_ == s21::SparseFormat::kCsr ? cols_ : rows_;
+}
+
+void S21SparseMatrix::Merge(const S21SparseMatrix &other, double sign) {
+  S21SparseMatrix converted;
+  const S21SparseMatrix *rhs = &other;
+  if (other.format_ != format_) {
+    converted = other.Convert(format_);
+    rhs = &converted;
+  }
+  std::vector<int> offsets(offsets_.size(), 0), indices;
+  std::vector<double> values;
+  indices.reserve(indices_.size() + rhs->indices_.size());
+  values.reserve(indices.capacity());
+  for (int k = 0; k < Major(); k++) {
+    int p = offsets_[k], q = rhs->offsets_[k];
+    while (p < offsets_[k + 1] || q < rhs->offsets_[k + 1]) {
+      int index;
+      double value;
+      if (q == rhs->offsets_[k + 1] ||
+          (p < offsets_[k + 1] && indices_[p] < rhs->indices_[q])) {
+        index = indices_[p];
+        value = values_[p++];
+      } else if (p == offsets_[k + 1] || rhs->indices_[q] < indices_[p]) {
+        index = rhs->indices_[q];
+        value = sign * rhs->values_[q++];
+      } else {
+        index = indices_[p];
+        value = values_[p++] + sign * rhs->values_[q++];
+      }
+      if (value != 0) {
+        indices.push_back(index);
+        values.push_back(value);
+      }
+    }
+    offsets[k + 1] = indices.size();
+  }
+  offsets_ = std::move(offsets);
+  indices_ = std::move(indices);
+  values_ = std::move(values);
+}
+
+// The same matrix stored the other way round, with format_ unchanged. The
+// counting sort visits entries in major order, so the new minor indices
+// come out ascending.
+S21SparseMatrix S21SparseMatrix::Flipped() const {
+  S21SparseMatrix result;
+  result.rows_ = rows_;
+  result.cols_ = cols_;
+  result.format_ = format_;
+  result.offsets_.assign(Minor() + 1, 0);
+  result.indices_.resize(indices_.size());
+  result.values_.resize(values_.size());
+  for (int index : indices_) result.offsets_[index + 1]++;
+  for (int k = 0; k < Minor(); k++)
+    result.offsets_[k + 1] += result.offsets_[k];
+  std::vector<int> next(result.offsets_.begin(), result.offsets_.end() - 1);
+  for (int k = 0; k < Major(); k++) {
+    for (int p = offsets_[k]; p < offsets_[k + 1]; p++) {
+      int q = next[indices_[p]]++;
+      result.indices_[q] = k;
+      result.values_[q] = values_[p];
+    }
+  }
+  return result;
+}
+
+// Gustavson's row-by-row product of compressed storages: row i of the
+// result accumulates rhs rows scaled by the entries of lhs row i in a dense
+// scratch row, touching only the columns that occur.
+void S21SparseMatrix::Multiply(const S21SparseMatrix &lhs,
+                               const S21SparseMatrix &rhs,
+                               S21SparseMatrix &result) {
+  int rows = lhs.Major(), cols = rhs.Minor();
+  std::vector<double> scratch(cols, 0.0);
+  std::vector<int> marker(cols, -1), pattern;
+  result.offsets_.assign(rows + 1, 0);
+  result.indices_.clear();
+  result.values_.clear();
+  for (int i = 0; i < rows; i++) {
+    pattern.clear();
+    for (int p = lhs.offsets_[i]; p < lhs.offsets_[i + 1]; p++) {
+      int k = lhs.indices_[p];
+      double value = lhs.values_[p];
+      for (int q = rhs.offsets_[k]; q < rhs.offsets_[k + 1]; q++) {
+        int j = rhs.indices_[q];
+        if (marker[j] != i) {
+          marker[j] = i;
+          scratch[j] = 0;
+          pattern.push_back(j);
+        }
+        scratch[j] += value * rhs.values_[q];
+      }
+    }
+    std::sort(pattern.begin(), pattern.end());
+    for (int j : pattern) {
+      if (scratch[j] != 0) {
+        result.indices_.push_back(j);
+        result.values_.push_back(scratch[j]);
+      }
+    }
+    result.offsets_[i + 1] = result.indices_.size();
+  }
+}
@@ -0,0 +1,71 @@
+#ifndef SRC_S21_SPARSE_MATRIX_H_
+#define SRC_S21_SPARSE_MATRIX_H_
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+namespace s21 {
+
+// kCsr keeps the entries of each row together, kCsc those of each column.
+enum class SparseFormat { kCsr, kCsc };
+
+struct Triplet {
+  int row, col;
+  double value;
+};
+
+}  // namespace s21
+
+// Compressed sparse matrix holding only its nonzero elements. In CSR
+// offsets_[k] .. offsets_[k + 1] delimit the entries of row k and indices_
+// holds their columns; CSC swaps the roles of rows and columns. Indices
+// within a row (column) are ascending. Results of every operation drop
+// entries that cancel to zero, and operations on operands of different
+// formats convert the right-hand one to the format of the left.
+class S21SparseMatrix {
+ public:
+  S21SparseMatrix() noexcept;
+  S21SparseMatrix(int rows, int cols,
+                  s21::SparseFormat format = s21::SparseFormat::kCsr);
+  // Entries with the same coordinates are summed.
+  S21SparseMatrix(int rows, int cols, const std::vector<s21::Triplet> &entries,
+                  s21::SparseFormat format = s21::SparseFormat::kCsr);
+  // Keeps the elements of dense whose magnitude exceeds threshold.
+  explicit S21SparseMatrix(
+      const S21Matrix &dense, double threshold = 0.0,
+      s21::SparseFormat format = s21::SparseFormat::kCsr);
+
+  int GetRows() const noexcept { return rows_; }
+  int GetCols() const noexcept { return cols_; }
+  int NonZeros() const noexcept { return indices_.size(); }
+  s21::SparseFormat GetFormat() const noexcept { return format_; }
+  double operator()(int row, int col) const;
+
+  S21Matrix ToDense() const;
+  S21SparseMatrix Convert(s21::SparseFormat format) const;
+
+  void SumMatrix(const S21SparseMatrix &other);
+  void SubMatrix(const S21SparseMatrix &other);
+  void MulNumber(const double num) noexcept;
+  void MulMatrix(const S21SparseMatrix &other);
+  S21SparseMatrix Transpose() const;
+  // Products with dense operands, computed in parallel for large inputs.
+  S21Matrix MulDense(const S21Matrix &other) const;
+  std::vector<double> MulVector(const std::vector<double> &vector) const;
+
+ private:
+  int Major() const noexcept;
+  int Minor() const noexcept;
+  void Merge(const S21SparseMatrix &other, double sign);
+  S21SparseMatrix Flipped() const;
+  static void Multiply(const S21SparseMatrix &lhs, const S21SparseMatrix &rhs,
+                       S21SparseMatrix &result);
+
+  int rows_, cols_;
+  s21::SparseFormat format_;
+  std::vector<int> offsets_, indices_;
+  std::vector<double> values_;
+};
+
+#endif  // SRC_S21_SPARSE_MATRIX_H_
@@ -0,0 +1,128 @@
+#include "s21_strassen.h"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include "s21_gemm.h"
+
+namespace s21 {
+
+namespace {
+
+std::atomic<int> g_crossover{1024};
+
+bool Recurse(int m, int n, int k, int crossover) noexcept {
+  return std::min({m, n, k}) > crossover;
+}
+
+// Elements needed by the temporaries of every recursion level below m, n, k.
+std::size_t WorkspaceSize(int m, int n, int k, int crossover) noexcept {
+  if (!Recurse(m, n, k, crossover)) return 0;
+  std::size_t mh = m / 2, nh = n / 2, kh = k / 2;
+  return mh * kh + kh * nh + mh * nh +
+         WorkspaceSize(m / 2, n / 2, k / 2, crossover);
+}
+
+// z = x + y and z = x - y over rows x cols blocks; z may alias x or y.
+template <typename T>
+void Add(int rows, int cols, const T *x, int x_rs, const T *y, int y_rs, T *z,
+         int z_rs) noexcept {
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++)
+      z[i * z_rs + j] = x[i * x_rs + j] + y[i * y_rs + j];
+  }
+}
+
+template <typename T>
+void Sub(int rows, int cols, const T *x, int x_rs, const T *y, int y_rs, T *z,
+         int z_rs) noexcept {
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++)
+      z[i * z_rs + j] = x[i * x_rs + j] - y[i * y_rs + j];
+  }
+}
+
+// C = A * B with the blocked kernel.
+template <typename T>
+void Classical(int m, int n, int k, const T *a, int a_rs, const T *b, int b_rs,
+               T *c, int c_rs) {
+  for (int i = 0; i < m; i++) std::fill(c + i * c_rs, c + i * c_rs + n, T(0));
+  Gemm(m, n, k, T(1), a, a_rs, 1, b, b_rs, 1, c, c_rs, 1);
+}
+
+template <typename T>
+void Multiply(int m, int n, int k, const T *a, int a_rs, const T *b, int b_rs,
+              T *c, int c_rs, T *workspace, int crossover) {
+  if (!Recurse(m, n, k, crossover)) {
+    Classical(m, n, k, a, a_rs, b, b_rs, c, c_rs);
+    return;
+  }
+  int mh = m / 2, nh = n / 2, kh = k / 2;
+  const T *a11 = a, *a12 = a + kh, *a21 = a + mh * a_rs, *a22 = a21 + kh;
+  const T *b11 = b, *b12 = b + nh, *b21 = b + kh * b_rs, *b22 = b21 + nh;
+  T *c11 = c, *c12 = c + nh, *c21 = c + mh * c_rs, *c22 = c21 + nh;
+  T *x = workspace, *y = x + mh * kh, *z = y + kh * nh;
+  T *next = z + mh * nh;
+
+  // Winograd's schedule, using the quadrants of C as scratch.
+  Sub(mh, kh, a11, a_rs, a21, a_rs, x, kh);
+  Sub(kh, nh, b22, b_rs, b12, b_rs, y, nh);
+  Multiply(mh, nh, kh, x, kh, y, nh, c21, c_rs, next, crossover);
+  Add(mh, kh, a21, a_rs, a22, a_rs, x, kh);
+  Sub(kh, nh, b12, b_rs, b11, b_rs, y, nh);
+  Multiply(mh, nh, kh, x, kh, y, nh, c22, c_rs, next, crossover);
+  Sub(mh, kh, x, kh, a11, a_rs, x, kh);
+  Sub(kh, nh, b22, b_rs, y, nh, y, nh);
+  Multiply(mh, nh, kh, x, kh, y, nh, c12, c_rs, next, crossover);
+  Sub(mh, kh, a12, a_rs, x, kh, x, kh);
+  Multiply(mh, nh, kh, x, kh, b22, b_rs, c11, c_rs, next, crossover);
+  Multiply(mh, nh, kh, a11, a_rs, b11, b_rs, z, nh, next, crossover);
+  Add(mh, nh, z, nh, c12, c_rs, c12, c_rs);
+  Add(mh, nh, c12, c_rs, c21, c_rs, c21, c_rs);
+  Add(mh, nh, c12, c_rs, c22, c_rs, c12, c_rs);
+  Add(mh, nh, c21, c_rs, c22, c_rs, c22, c_rs);
+  Add(mh, nh, c12, c_rs, c11, c_rs, c12, c_rs);
+  Sub(kh, nh, y, nh, b21, b_rs, y, nh);
+  Multiply(mh, nh, kh, a22, a_rs, y, nh, c11, c_rs, next, crossover);
+  Sub(mh, nh, c21, c_rs, c11, c_rs, c21, c_rs);
+  Multiply(mh, nh, kh, a12, a_rs, b21, b_rs, c11, c_rs, next, crossover);
+  Add(mh, nh, z, nh, c11, c_rs, c11, c_rs);
+
+  // Peel the odd last row, column and inner index.
+  int m2 = 2 * mh, n2 = 2 * nh, k2 = 2 * kh;
+  if (k2 < k)
+    Gemm(m2, n2, 1, T(1), a + k2, a_rs, 1, b + k2 * b_rs, b_rs, 1, c, c_rs, 1);
+  if (n2 < n) Classical(m, 1, k, a, a_rs, b + n2, b_rs, c + n2, c_rs);
+  if (m2 < m)
+    Classical(1, n2, k, a + m2 * a_rs, a_rs, b, b_rs, c + m2 * c_rs, c_rs);
+}
+
+}  // namespace
+
+void SetStrassenCrossover(int crossover) noexcept {
+  g_crossover = std::max(crossover, 1);
+}
+
+int GetStrassenCrossover() noexcept { return g_crossover; }
+
+bool PreferStrassen(int m, int n, int k) noexcept {
+  return std::min({m, n, k}) > 2 * GetStrassenCrossover();
+}
+
+template <typename T>
+void StrassenGemm(int m, int n, int k, const T *a, int a_rs, const T *b,
+                  int b_rs, T *c, int c_rs) {
+  int crossover = GetStrassenCrossover();
+  std::vector<T> workspace(WorkspaceSize(m, n, k, crossover));
+  Multiply(m, n, k, a, a_rs, b, b_rs, c, c_rs, workspace.data(), crossover);
+}
+
+template void StrassenGemm(int, int, int, const float *, int, const float *,
+                           int, float *, int);
+template void StrassenGemm(int, int, int, const double *, int, const double *,
+                           int, double *, int);
+template void StrassenGemm(int, int, int, const long double *, int,
+                           const long double *, int, long double *, int);
+
+}  // namespace s21
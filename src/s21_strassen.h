@@ -0,0 +1,28 @@
+#ifndef SRC_S21_STRASSEN_H_
+#define SRC_S21_STRASSEN_H_
+
+#include <cstddef>
+
+namespace s21 {
+
+// Strassen-Winograd recursion stops once any dimension of a subproduct is
+// at most the crossover; the blocked kernel computes it from there.
+void SetStrassenCrossover(int crossover) noexcept;
+int GetStrassenCrossover() noexcept;
+
+// Whether MulAlgorithm::kAuto picks Strassen-Winograd for an m x k by k x n
+// product: every dimension must allow at least two levels of recursion.
+bool PreferStrassen(int m, int n, int k) noexcept;
+
+// Computes C = A * B for row-major operands with row strides a_rs, b_rs and
+// c_rs (A is m x k, B is k x n), using seven half-size products per level.
+// Odd dimensions are peeled off and finished with the blocked kernel. All
+// temporaries come from a single workspace allocated up front.
+// Instantiated for float, double and long double.
+template <typename T>
+void StrassenGemm(int m, int n, int k, const T *a, int a_rs, const T *b,
+                  int b_rs, T *c, int c_rs);
+
+}  // namespace s21
+
+#endif  // SRC_S21_STRASSEN_H_
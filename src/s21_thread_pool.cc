@@ -0,0 +1,123 @@
+#include "s21_thread_pool.h"
+
+namespace s21 {
+
+namespace {
+
+// Set on pool workers for their whole life, on a submitting thread while it
+// helps with its own work and inside a SerialScope.
+thread_local bool t_serial = false;
+
+}  // namespace
+
+ThreadPool &ThreadPool::Instance() {
+  static ThreadPool pool;
+  return pool;
+}
+
+ThreadPool::ThreadPool()
+    : worker_count_(0),
+      task_(nullptr),
+      task_count_(0),
+      pending_workers_(0),
+      next_task_(0),
+      generation_(0),
+      stop_(false) {
+  Start(0);
+}
+
+ThreadPool::~ThreadPool() { Stop(); }
+
+void ThreadPool::SetThreadCount(int count) {
+  std::lock_guard<std::mutex> submit(submit_mutex_);
+  Stop();
+  Start(count);
+}
+
+int ThreadPool::GetThreadCount() const noexcept { return worker_count_ + 1; }
+
+bool ThreadPool::Serial() const noexcept {
+  return t_serial || worker_count_ == 0;
+}
+
+void ThreadPool::ParallelFor(int count, const std::function<void(int)> &task) {
+  if (count <= 0) return;
+  if (count == 1 || Serial()) {
+    for (int i = 0; i < count; i++) task(i);
+    return;
+  }
+  std::unique_lock<std::mutex> submit(submit_mutex_);
+  // The pool may have shrunk to no workers since the check above.
+  if (workers_.empty()) {
+    submit.unlock();
+    for (int i = 0; i < count; i++) task(i);
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    task_ = &task;
+    task_count_ = count;
+    next_task_ = 0;
+    pending_workers_ = static_cast<int>(workers_.size());
+    error_ = nullptr;
+    generation_++;
+  }
+  wake_.notify_all();
+  t_serial = true;
+  RunTasks();
+  t_serial = false;
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_.wait(lock, [this] { return pending_workers_ == 0; });
+  task_ = nullptr;
+  if (error_) std::rethrow_exception(error_);
+}
+
+void ThreadPool::Start(int count) {
+  if (count <= 0) count = static_cast<int>(std::thread::hardware_concurrency());
+  stop_ = false;
+  for (int i = 1; i < count; i++)
+    workers_.emplace_back(&ThreadPool::WorkerLoop, this, generation_);
+  worker_count_ = static_cast<int>(workers_.size());
+}
+
+void ThreadPool::Stop() {
+  worker_count_ = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  for (std::thread &worker : workers_) worker.join();
+  workers_.clear();
+}
+
+void ThreadPool::WorkerLoop(unsigned seen) {
+  t_serial = true;
+  for (;;) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+    if (stop_) return;
+    seen = generation_;
+    lock.unlock();
+    RunTasks();
+    lock.lock();
+    if (--pending_workers_ == 0) done_.notify_one();
+  }
+}
+
+void ThreadPool::RunTasks() {
+  for (int i = next_task_++; i < task_count_; i = next_task_++) {
+    try {
+      (*task_)(i);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!error_) error_ = std::current_exception();
+    }
+  }
+}
+
+SerialScope::SerialScope() noexcept : previous_(t_serial) { t_serial = true; }
+
+SerialScope::~SerialScope() { t_serial = previous_; }
+
+}  // namespace s21
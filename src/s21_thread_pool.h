@@ -0,0 +1,72 @@
+#ifndef SRC_S21_THREAD_POOL_H_
+#define SRC_S21_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace s21 {
+
+// Library-owned pool of persistent workers used by the parallel kernels.
+// The thread that submits work takes part in it, so a pool of n threads
+// keeps n - 1 workers. Work submitted from inside a task, or while a
+// SerialScope is alive on the submitting thread, runs inline.
+class ThreadPool {
+ public:
+  static ThreadPool &Instance();
+
+  // Zero or a negative count selects std::thread::hardware_concurrency().
+  // Waits for work in flight; kernels running meanwhile on other threads
+  // see either the old or the new count.
+  void SetThreadCount(int count);
+  int GetThreadCount() const noexcept;
+  bool Serial() const noexcept;
+
+  // Calls task(i) for every i in [0, count) and returns once all calls are
+  // done. The first exception thrown by a task is rethrown here.
+  void ParallelFor(int count, const std::function<void(int)> &task);
+
+ private:
+  ThreadPool();
+  ~ThreadPool();
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  void Start(int count);
+  void Stop();
+  void WorkerLoop(unsigned seen);
+  void RunTasks();
+
+  std::vector<std::thread> workers_;
+  // workers_.size() for readers that do not hold submit_mutex_.
+  std::atomic<int> worker_count_;
+  std::mutex submit_mutex_, mutex_;
+  std::condition_variable wake_, done_;
+  const std::function<void(int)> *task_;
+  int task_count_, pending_workers_;
+  std::atomic<int> next_task_;
+  unsigned generation_;
+  bool stop_;
+  std::exception_ptr error_;
+};
+
+// Keeps every kernel called on the current thread single-threaded while the
+// object is alive. Meant for callers that already run inside their own pool.
+class SerialScope {
+ public:
+  SerialScope() noexcept;
+  ~SerialScope();
+  SerialScope(const SerialScope &) = delete;
+  SerialScope &operator=(const SerialScope &) = delete;
+
+ private:
+  bool previous_;
+};
+
+}  // namespace s21
+
+#endif  // SRC_S21_THREAD_POOL_H_
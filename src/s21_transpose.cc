@@ -0,0 +1,92 @@
+#include "s21_transpose.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "s21_simd.h"
+
+namespace s21 {
+
+namespace {
+
+// Side of the leaf blocks: a source and a destination tile of doubles take
+// 16 KB together, tiles of floats half as much.
+constexpr int kTile = 32;
+
+}  // namespace
+
+template <typename T>
+void Transpose(int rows, int cols, const T *src, int src_stride, T *dst,
+               int dst_stride) noexcept {
+  if (rows <= kTile && cols <= kTile) {
+    simd::TransposeBlock(rows, cols, src, src_stride, dst, dst_stride);
+  } else if (rows >= cols) {
+    int half = rows / 2;
+    Transpose(half, cols, src, src_stride, dst, dst_stride);
+    Transpose(rows - half, cols, src + half * src_stride, src_stride,
+              dst + half, dst_stride);
+  } else {
+    int half = cols / 2;
+    Transpose(rows, half, src, src_stride, dst, dst_stride);
+    Transpose(rows, cols - half, src + half, src_stride,
+              dst + half * dst_stride, dst_stride);
+  }
+}
+
+template <typename T>
+void TransposeSquareInPlace(int n, T *a, int stride) noexcept {
+  T buffer[kTile * kTile];
+  for (int bi = 0; bi < n; bi += kTile) {
+    int rows = std::min(kTile, n - bi);
+    T *diagonal = a + bi * stride + bi;
+    for (int i = 0; i < rows; i++) {
+      for (int j = i + 1; j < rows; j++)
+        std::swap(diagonal[i * stride + j], diagonal[j * stride + i]);
+    }
+    for (int bj = bi + kTile; bj < n; bj += kTile) {
+      int cols = std::min(kTile, n - bj);
+      T *upper = a + bi * stride + bj;
+      T *lower = a + bj * stride + bi;
+      simd::TransposeBlock(rows, cols, upper, stride, buffer, rows);
+      simd::TransposeBlock(cols, rows, lower, stride, upper, stride);
+      for (int i = 0; i < cols; i++)
+        std::copy(buffer + i * rows, buffer + (i + 1) * rows,
+                  lower + i * stride);
+    }
+  }
+}
+
+template <typename T>
+void TransposeDenseInPlace(int rows, int cols, T *a) {
+  std::size_t size = static_cast<std::size_t>(rows) * cols;
+  if (size < 3 || rows == 1 || cols == 1) return;
+  // Element k of the source moves to k * rows mod (size - 1); the first and
+  // last elements stay put.
+  std::size_t modulus = size - 1;
+  std::vector<bool> visited(size);
+  for (std::size_t start = 1; start < modulus; start++) {
+    if (visited[start]) continue;
+    std::size_t k = start;
+    T carried = a[k];
+    do {
+      std::size_t next = k * rows % modulus;
+      std::swap(carried, a[next]);
+      visited[next] = true;
+      k = next;
+    } while (k != start);
+  }
+}
+
+template void Transpose(int, int, const float *, int, float *, int) noexcept;
+template void Transpose(int, int, const double *, int, double *, int) noexcept;
+template void Transpose(int, int, const long double *, int, long double *,
+                        int) noexcept;
+template void TransposeSquareInPlace(int, float *, int) noexcept;
+template void TransposeSquareInPlace(int, double *, int) noexcept;
+template void TransposeSquareInPlace(int, long double *, int) noexcept;
+template void TransposeDenseInPlace(int, int, float *);
+template void TransposeDenseInPlace(int, int, double *);
+template void TransposeDenseInPlace(int, int, long double *);
+
+}  // namespace s21
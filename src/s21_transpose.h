@@ -0,0 +1,27 @@
+#ifndef SRC_S21_TRANSPOSE_H_
+#define SRC_S21_TRANSPOSE_H_
+
+namespace s21 {
+
+// All kernels are instantiated for float, double and long double.
+
+// dst(j, i) = src(i, j) for a rows x cols row-major source. The shape is
+// halved recursively along its longer side until a block fits in L1, so
+// the kernel is cache-friendly at every level without tuning.
+template <typename T>
+void Transpose(int rows, int cols, const T *src, int src_stride, T *dst,
+               int dst_stride) noexcept;
+
+// Transposes the n x n matrix in place by swapping mirrored tiles.
+template <typename T>
+void TransposeSquareInPlace(int n, T *a, int stride) noexcept;
+
+// Transposes a dense (stride == cols) rows x cols matrix in place by
+// following the cycles of the index permutation, using one bit of scratch
+// per element.
+template <typename T>
+void TransposeDenseInPlace(int rows, int cols, T *a);
+
+}  // namespace s21
+
+#endif  // SRC_S21_TRANSPOSE_H_
@@ -1,6 +1,16 @@
 #include <gtest/gtest.h>
 
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+#include "s21_fixed_matrix.h"
+#include "s21_matrix_batch.h"
 #include "s21_matrix_oop.h"
+#include "s21_solve.h"
+#include "s21_sparse_matrix.h"
+#include "s21_strassen.h"
+#include "s21_thread_pool.h"
 
 TEST(Constructors, DefaultConstructor) {
   S21Matrix matrix_1;
@@ -220,6 +230,14 @@ TEST(Operators, Operatormulmatrix1) {
   matrix_3(3, 0) = 499.0;
   matrix_3(3, 1) = 532.0;
 
+  // The product leaves its operands alone.
+  const S21Matrix copy_1 = matrix_1, copy_2 = matrix_2;
+  S21Matrix product = matrix_1 * matrix_2;
+  ASSERT_TRUE(product == matrix_3);
+  ASSERT_TRUE(matrix_1 == copy_1);
+  ASSERT_TRUE(matrix_2 == copy_2);
+  ASSERT_TRUE(copy_1 * copy_2 == matrix_3);
+
   matrix_1 = matrix_1 * matrix_2;
 
   for (int i = 0; i < 4; i++) {
@@ -798,6 +816,1190 @@ TEST(Inverse, InverseMatrix2) {
   EXPECT_THROW(matrix_2.InverseMatrix(), std::logic_error);
 }
 
+TEST(Constructors, ContiguousStorage) {
+  S21Matrix matrix_1(9, 13);
+  for (int i = 0; i < 9; i++) {
+    for (int j = 0; j < 13; j++) {
+      matrix_1(i, j) = i * 13 + j;
+    }
+  }
+  S21Matrix matrix_2(matrix_1);
+  S21Matrix matrix_3;
+  matrix_3 = matrix_2;
+  matrix_3.SetCols(14);
+
+  for (int i = 0; i < 9; i++) {
+    for (int j = 0; j < 13; j++) {
+      ASSERT_DOUBLE_EQ(i * 13 + j, matrix_2(i, j));
+      ASSERT_DOUBLE_EQ(i * 13 + j, matrix_3(i, j));
+    }
+    ASSERT_DOUBLE_EQ(0.0, matrix_3(i, 13));
+  }
+}
+
+TEST(Arithmetics, MulMatrixBlocked) {
+  const int sizes[][3] = {{67, 45, 71}, {37, 300, 29}, {130, 9, 140}};
+  for (const auto &size : sizes) {
+    S21Matrix matrix_1(size[0], size[1]);
+    S21Matrix matrix_2(size[1], size[2]);
+    for (int i = 0; i < size[0]; i++) {
+      for (int j = 0; j < size[1]; j++) matrix_1(i, j) = (i * 7 + j) % 13 - 6;
+    }
+    for (int i = 0; i < size[1]; i++) {
+      for (int j = 0; j < size[2]; j++) matrix_2(i, j) = (i + 3 * j) % 11 - 5;
+    }
+    S21Matrix result(matrix_1);
+    ASSERT_NO_THROW(result.MulMatrix(matrix_2));
+    ASSERT_EQ(size[0], result.GetRows());
+    ASSERT_EQ(size[2], result.GetCols());
+    for (int i = 0; i < size[0]; i++) {
+      for (int j = 0; j < size[2]; j++) {
+        double expected = 0.0;
+        for (int k = 0; k < size[1]; k++)
+          expected += matrix_1(i, k) * matrix_2(k, j);
+        ASSERT_DOUBLE_EQ(expected, result(i, j));
+      }
+    }
+  }
+}
+
+TEST(Determinant, DeterminantLarge) {
+  S21Matrix matrix_1(15, 15);
+  S21Matrix matrix_2(6, 6);
+  for (int i = 0; i < 15; i++) {
+    matrix_1(i, i) = 2.0;
+    if (i > 0) matrix_1(i, i - 1) = -1.0;
+    if (i < 14) matrix_1(i, i + 1) = -1.0;
+  }
+  for (int i = 0; i < 6; i++) matrix_2(i, 5 - i) = 1.0;
+
+  EXPECT_NEAR(16.0, matrix_1.Determinant(), 1e-9);
+  ASSERT_DOUBLE_EQ(-1.0, matrix_2.Determinant());
+  matrix_2(0, 5) = 0.0;
+  ASSERT_DOUBLE_EQ(0.0, matrix_2.Determinant());
+}
+
+TEST(Inverse, InverseMatrixLarge) {
+  const int size = 40;
+  S21Matrix matrix_1(size, size);
+  for (int i = 0; i < size; i++) {
+    for (int j = 0; j < size; j++) matrix_1(i, j) = 1.0 / (i + j + 1.0);
+    matrix_1(i, i) += size;
+  }
+  S21Matrix matrix_2 = matrix_1.InverseMatrix();
+  S21Matrix product(matrix_1);
+  product.MulMatrix(matrix_2);
+
+  for (int i = 0; i < size; i++) {
+    for (int j = 0; j < size; j++) {
+      EXPECT_NEAR(i == j ? 1.0 : 0.0, product(i, j), 1e-12);
+    }
+  }
+}
+
+TEST(Inverse, InverseMatrixSingular) {
+  S21Matrix matrix_1(3, 3);
+  S21Matrix matrix_2(2, 3);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) matrix_1(i, j) = 0.1 * (i * 3 + j + 1);
+  }
+
+  EXPECT_THROW(matrix_1.InverseMatrix(), std::logic_error);
+  EXPECT_THROW(matrix_2.InverseMatrix(), std::logic_error);
+}
+
+TEST(Complement, CalcComplementLarge) {
+  const int size = 12;
+  S21Matrix matrix_1(size, size);
+  for (int i = 0; i < size; i++) {
+    for (int j = 0; j < size; j++) matrix_1(i, j) = (i * 5 + j * 3) % 7 - 3;
+    matrix_1(i, i) += 10.0;
+  }
+  S21Matrix matrix_2 = matrix_1.CalcComplements();
+
+  for (int i = 0; i < size; i += 5) {
+    for (int j = 0; j < size; j += 3) {
+      double expected = ((i + j) % 2 ? -1 : 1) *
+                        matrix_1.MinorMatrix(i, j).Determinant();
+      EXPECT_NEAR(expected, matrix_2(i, j), std::abs(expected) * 1e-10);
+    }
+  }
+}
+
+TEST(Complement, CalcComplementSingular) {
+  const int size = 6;
+  S21Matrix matrix_1(size, size);
+  S21Matrix matrix_2(size, size);
+  for (int i = 0; i < size; i++) {
+    for (int j = 0; j < size; j++) {
+      matrix_1(i, j) = i == j ? 2.0 : 0.5;
+      matrix_2(i, j) = i + j;
+    }
+  }
+  for (int j = 0; j < size; j++) matrix_1(size - 1, j) = matrix_1(0, j);
+  S21Matrix matrix_3 = matrix_1.CalcComplements();
+  S21Matrix matrix_4 = matrix_2.CalcComplements();
+
+  for (int i = 0; i < size; i++) {
+    for (int j = 0; j < size; j++) {
+      double expected = ((i + j) % 2 ? -1 : 1) *
+                        matrix_1.MinorMatrix(i, j).Determinant();
+      EXPECT_NEAR(expected, matrix_3(i, j), 1e-9);
+      ASSERT_DOUBLE_EQ(0.0, matrix_4(i, j));
+    }
+  }
+  ASSERT_NE(0.0, matrix_3(0, 0));
+}
+
+TEST(Arithmetics, MulMatrixParallel) {
+  S21Matrix matrix_1(203, 150);
+  S21Matrix matrix_2(150, 177);
+  for (int i = 0; i < 203; i++) {
+    for (int j = 0; j < 150; j++) matrix_1(i, j) = (i * 7 + j) % 13 - 6;
+  }
+  for (int i = 0; i < 150; i++) {
+    for (int j = 0; j < 177; j++) matrix_2(i, j) = (i + 3 * j) % 11 - 5;
+  }
+  s21::ThreadPool &pool = s21::ThreadPool::Instance();
+  int threads = pool.GetThreadCount();
+  S21Matrix serial(matrix_1);
+  {
+    s21::SerialScope scope;
+    serial.MulMatrix(matrix_2);
+  }
+  pool.SetThreadCount(4);
+  ASSERT_EQ(4, pool.GetThreadCount());
+  S21Matrix parallel = matrix_1 * matrix_2;
+  EXPECT_THROW(pool.ParallelFor(8,
+                                [](int i) {
+                                  if (i == 5) throw std::range_error("task");
+                                }),
+               std::range_error);
+  // Kernels keep working while another thread resizes the pool.
+  std::thread resizer([&pool] {
+    for (int i = 0; i < 20; i++) pool.SetThreadCount(i % 3 + 1);
+  });
+  for (int i = 0; i < 5; i++) EXPECT_TRUE(matrix_1 * matrix_2 == serial);
+  resizer.join();
+  pool.SetThreadCount(threads);
+
+  ASSERT_TRUE(serial == parallel);
+}
+
+TEST(Operators, FusedExpression) {
+  S21Matrix matrix_1(3, 4);
+  S21Matrix matrix_2(3, 4);
+  S21Matrix matrix_3(3, 4);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 4; j++) {
+      matrix_1(i, j) = i + j;
+      matrix_2(i, j) = i * j;
+      matrix_3(i, j) = i - j;
+    }
+  }
+
+  S21Matrix result = matrix_1 + matrix_2 - matrix_3 * 2.0;
+  S21Matrix matrix_4(matrix_1);
+  matrix_4 = 0.5 * (matrix_4 - matrix_2) + matrix_4;
+  S21Matrix matrix_5;
+  matrix_5 = matrix_3 * 3.0;
+
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 4; j++) {
+      ASSERT_DOUBLE_EQ(i + j + i * j - 2.0 * (i - j), result(i, j));
+      ASSERT_DOUBLE_EQ(1.5 * (i + j) - 0.5 * i * j, matrix_4(i, j));
+      ASSERT_DOUBLE_EQ(3.0 * (i - j), matrix_5(i, j));
+    }
+  }
+  EXPECT_THROW(S21Matrix(matrix_1 + matrix_2 - S21Matrix(4, 3)),
+               std::logic_error);
+}
+
+TEST(FixedMatrix, Arithmetics) {
+  S21FixedMatrix<2, 3> matrix_1;
+  S21FixedMatrix<3, 2> matrix_2;
+  for (int i = 0; i < 2; i++) {
+    for (int j = 0; j < 3; j++) {
+      matrix_1(i, j) = i * 3 + j + 1;
+      matrix_2(j, i) = j - i;
+    }
+  }
+  S21Matrix dynamic_1(matrix_1);
+  S21Matrix dynamic_2(matrix_2);
+  dynamic_1.MulMatrix(dynamic_2);
+  S21FixedMatrix<2, 2> product = matrix_1 * matrix_2;
+  S21FixedMatrix<2, 3> sum = matrix_1 + matrix_2.Transpose() * 2.0;
+
+  static_assert(S21FixedMatrix<2, 3>::GetCols() == 3, "Cols are constexpr");
+  ASSERT_TRUE((S21FixedMatrix<2, 2>(dynamic_1) == product));
+  ASSERT_DOUBLE_EQ(matrix_1(1, 2) + 2.0 * matrix_2(2, 1), sum(1, 2));
+  EXPECT_THROW((S21FixedMatrix<2, 2>{dynamic_2}), std::logic_error);
+}
+
+TEST(FixedMatrix, DeterminantInverse) {
+  S21FixedMatrix<3, 3> matrix_1;
+  S21FixedMatrix<4, 4> matrix_2;
+  S21FixedMatrix<5, 5> matrix_3;
+  const double values[4][4] = {{1.8, 7.9, 5.0, 1.9},
+                               {87.0, 7.0, 6.9, 8.1},
+                               {6.2, 13.8, 11.5, -18.0},
+                               {-2.0, 23.8, 7.7, 7.5}};
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) matrix_1(i, j) = i + j * j + (i == j);
+  }
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) matrix_2(i, j) = values[i][j];
+  }
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 5; j++) matrix_3(i, j) = (i * 3 + j * 7) % 5 + (i == j);
+  }
+  S21FixedMatrix<3, 3> product_1 = matrix_1 * matrix_1.InverseMatrix();
+  S21FixedMatrix<4, 4> product_2 = matrix_2 * matrix_2.InverseMatrix();
+  S21FixedMatrix<5, 5> product_3 = matrix_3 * matrix_3.InverseMatrix();
+
+  ASSERT_DOUBLE_EQ(S21Matrix(matrix_1).Determinant(), matrix_1.Determinant());
+  EXPECT_NEAR(99717.2406, matrix_2.Determinant(), 1e-7);
+  EXPECT_NEAR(S21Matrix(matrix_3).Determinant(), matrix_3.Determinant(), 1e-9);
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 5; j++) {
+      if (i < 3 && j < 3) {
+        EXPECT_NEAR(i == j, product_1(i, j), 1e-12);
+      }
+      if (i < 4 && j < 4) {
+        EXPECT_NEAR(i == j, product_2(i, j), 1e-12);
+      }
+      EXPECT_NEAR(i == j, product_3(i, j), 1e-12);
+    }
+  }
+  EXPECT_THROW((S21FixedMatrix<4, 4>().InverseMatrix()), std::logic_error);
+
+  // Singular, with a determinant left over from rounding: rejected like
+  // S21Matrix does, while a small but regular matrix is not.
+  S21FixedMatrix<3, 3> nearly_singular, small;
+  S21FixedMatrix<4, 4> nearly_singular_4;
+  for (int i = 0; i < 16; i++) {
+    if (i < 9) nearly_singular(i / 3, i % 3) = 0.1 * (i + 1);
+    nearly_singular_4(i / 4, i % 4) = 0.1 * (i + 1);
+  }
+  for (int i = 0; i < 3; i++) small(i, i) = 1e-3;
+  EXPECT_THROW(S21Matrix(nearly_singular).InverseMatrix(), std::logic_error);
+  EXPECT_THROW(nearly_singular.InverseMatrix(), std::logic_error);
+  EXPECT_THROW(nearly_singular_4.InverseMatrix(), std::logic_error);
+  ASSERT_DOUBLE_EQ(1e3, small.InverseMatrix()(2, 2));
+}
+
+TEST(Comparison, EqualMatrixTolerance) {
+  S21Matrix matrix_1(3, 7);
+  matrix_1.FillMatrix(1.5);
+  for (int j = 0; j < 7; j++) {
+    S21Matrix matrix_2(matrix_1);
+    matrix_2(2, j) += 0.5e-7;
+    ASSERT_TRUE(matrix_1 == matrix_2);
+    matrix_2(2, j) -= 2e-7;
+    ASSERT_FALSE(matrix_1 == matrix_2);
+    matrix_2 -= matrix_1;
+    matrix_2 *= -1e7;
+    ASSERT_NEAR(1.5, matrix_2(2, j), 1e-6);
+  }
+}
+
+TEST(MatrixPool, ReusesTemporaries) {
+  S21Matrix matrix_1(6, 6);
+  for (int i = 0; i < 6; i++) {
+    for (int j = 0; j < 6; j++) matrix_1(i, j) = (i * 5 + j * 3) % 7 + (i == j);
+  }
+  S21Matrix expected = matrix_1.CalcComplements();
+  S21Matrix escaped;
+  {
+    s21::MatrixPool pool;
+    { S21Matrix temporary(6, 6); }
+    std::size_t cached = pool.CachedBytes();
+    ASSERT_GT(cached, 0u);
+    S21Matrix reused(6, 6);
+    ASSERT_EQ(0u, pool.CachedBytes());
+    ASSERT_DOUBLE_EQ(0.0, reused(5, 5));
+    {
+      s21::MatrixPool inner(0);
+      { S21Matrix temporary(6, 6); }
+      ASSERT_EQ(0u, inner.CachedBytes());
+    }
+    escaped = matrix_1.CalcComplements();
+    ASSERT_GT(pool.CachedBytes(), 0u);
+  }
+  ASSERT_TRUE(escaped == expected);
+
+  // A buffer transposed in place goes back under the size it was allocated
+  // with, so the next matrix of the original shape reuses it.
+  s21::MatrixPool pool;
+  { S21Matrix tall(40, 3); }
+  std::size_t tall_bytes = pool.CachedBytes();
+  {
+    S21Matrix tall(40, 3);
+    tall(39, 2) = 1.0;
+    tall.TransposeInPlace();
+    ASSERT_DOUBLE_EQ(1.0, tall(2, 39));
+  }
+  ASSERT_EQ(tall_bytes, pool.CachedBytes());
+  S21Matrix reused(40, 3);
+  ASSERT_EQ(0u, pool.CachedBytes());
+}
+
+TEST(MatrixView, BlockRowColTranspose) {
+  S21Matrix matrix_1(4, 5);
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 5; j++) matrix_1(i, j) = i * 5 + j;
+  }
+  s21::MatrixView block = matrix_1.Block(1, 2, 2, 3);
+  s21::ConstMatrixView column = matrix_1.ColView(4);
+  s21::ConstMatrixView transposed = matrix_1.TransposedView();
+
+  ASSERT_EQ(2, block.GetRows());
+  ASSERT_DOUBLE_EQ(7.0, block(0, 0));
+  ASSERT_DOUBLE_EQ(14.0, block.RowView(1)(0, 2));
+  ASSERT_DOUBLE_EQ(19.0, column(3, 0));
+  ASSERT_DOUBLE_EQ(matrix_1(3, 1), transposed(1, 3));
+  ASSERT_TRUE(matrix_1.Transpose().EqMatrix(transposed));
+  EXPECT_THROW(matrix_1.Block(3, 0, 2, 1), std::range_error);
+  EXPECT_THROW(block(2, 0), std::range_error);
+
+  block.MulNumber(-1.0);
+  block.Transpose().ColView(0).FillMatrix(100.0);
+  ASSERT_DOUBLE_EQ(93.0, matrix_1(1, 2));
+  ASSERT_DOUBLE_EQ(91.0, matrix_1(1, 4));
+  ASSERT_DOUBLE_EQ(-14.0, matrix_1(2, 4));
+  ASSERT_DOUBLE_EQ(15.0, matrix_1(3, 0));
+}
+
+TEST(MatrixView, Arithmetics) {
+  S21Matrix matrix_1(6, 6);
+  for (int i = 0; i < 6; i++) {
+    for (int j = 0; j < 6; j++) matrix_1(i, j) = (i * 5 + j * 3) % 7 + (i == j);
+  }
+  S21Matrix top_left(matrix_1.Block(0, 0, 3, 3));
+  S21Matrix bottom_left(matrix_1.Block(3, 0, 3, 3));
+  S21Matrix bottom_right(matrix_1.Block(3, 3, 3, 3));
+  S21Matrix product(top_left);
+  product.MulMatrix(bottom_right);
+  S21Matrix product_transposed(top_left);
+  product_transposed.MulMatrix(bottom_right.Transpose());
+
+  S21Matrix matrix_2(top_left);
+  matrix_2.MulMatrix(matrix_1.Block(3, 3, 3, 3).Transpose());
+  ASSERT_TRUE(matrix_2 == product_transposed);
+  S21Matrix matrix_3(top_left);
+  matrix_3.SumMatrix(matrix_1.Block(3, 3, 3, 3));
+  ASSERT_TRUE(matrix_3 == top_left + bottom_right);
+  matrix_3.SubMatrix(bottom_right.View());
+  ASSERT_TRUE(matrix_3.EqMatrix(matrix_1.Block(0, 0, 3, 3)));
+  ASSERT_DOUBLE_EQ(top_left.Determinant(),
+                   matrix_1.Block(0, 0, 3, 3).Determinant());
+
+  matrix_1.Block(0, 3, 3, 3) = top_left - matrix_1.Block(3, 0, 3, 3) * 2.0;
+  matrix_1.Block(3, 0, 3, 3).AssignProduct(top_left, bottom_right);
+  ASSERT_DOUBLE_EQ(top_left(1, 2) - 2.0 * bottom_left(1, 2), matrix_1(1, 5));
+  ASSERT_TRUE(matrix_1.Block(3, 0, 3, 3).EqMatrix(product));
+  EXPECT_THROW(matrix_1.Block(0, 0, 2, 2) = top_left, std::logic_error);
+}
+
+TEST(MatrixView, AliasedAssignment) {
+  S21Matrix matrix(3, 3), original(3, 3);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) matrix(i, j) = original(i, j) = i * 3 + j + 1;
+  }
+  S21Matrix square(matrix);
+  square = square.TransposedView();
+  ASSERT_TRUE(square == original.Transpose());
+  square = original;
+  square = square.TransposedView() + square * 2.0;
+  ASSERT_TRUE(square == original.Transpose() + original * 2.0);
+  square = square - square;
+  ASSERT_TRUE(square == S21Matrix(3, 3));
+
+  matrix = matrix.Block(0, 0, 2, 2);
+  ASSERT_EQ(2, matrix.GetRows());
+  ASSERT_EQ(2, matrix.GetCols());
+  ASSERT_DOUBLE_EQ(4.0, matrix(1, 0));
+  ASSERT_DOUBLE_EQ(5.0, matrix(1, 1));
+
+  // Views write through, reading their source before overwriting it.
+  square = original;
+  square.Block(1, 1, 2, 2) = square.Block(0, 0, 2, 2);
+  ASSERT_DOUBLE_EQ(1.0, square(1, 1));
+  ASSERT_DOUBLE_EQ(5.0, square(2, 2));
+  square = original;
+  s21::MatrixView view = square.View();
+  view = view.Transpose() - original;
+  ASSERT_TRUE(square == original.Transpose() - original);
+}
+
+TEST(Transpose, TransposeLargeAndInPlace) {
+  const int sizes[][2] = {{70, 70}, {40, 67}, {37, 70}, {1, 9}, {130, 3}};
+  for (const auto &size : sizes) {
+    S21Matrix matrix_1(size[0], size[1]);
+    for (int i = 0; i < size[0]; i++) {
+      for (int j = 0; j < size[1]; j++) matrix_1(i, j) = i * 1000 + j;
+    }
+    S21Matrix matrix_2 = matrix_1.Transpose();
+    S21Matrix matrix_3(matrix_1);
+    matrix_3.TransposeInPlace();
+
+    ASSERT_EQ(size[1], matrix_2.GetRows());
+    ASSERT_EQ(size[1], matrix_3.GetRows());
+    ASSERT_EQ(size[0], matrix_3.GetCols());
+    for (int i = 0; i < size[0]; i++) {
+      for (int j = 0; j < size[1]; j++) {
+        ASSERT_DOUBLE_EQ(matrix_1(i, j), matrix_2(j, i));
+        ASSERT_DOUBLE_EQ(matrix_1(i, j), matrix_3(j, i));
+      }
+    }
+    matrix_3.SetCols(size[0] + 1);
+    ASSERT_DOUBLE_EQ(0.0, matrix_3(size[1] - 1, size[0]));
+  }
+}
+
+TEST(Arithmetics, MulMatrixStrassen) {
+  const int sizes[][3] = {{64, 64, 64}, {101, 67, 83}, {40, 90, 33}};
+  int crossover = s21::GetStrassenCrossover();
+  s21::SetStrassenCrossover(8);
+  for (const auto &size : sizes) {
+    S21Matrix matrix_1(size[0], size[1]);
+    S21Matrix matrix_2(size[1], size[2]);
+    for (int i = 0; i < size[0]; i++) {
+      for (int j = 0; j < size[1]; j++) matrix_1(i, j) = (i * 7 + j) % 13 - 6;
+    }
+    for (int i = 0; i < size[1]; i++) {
+      for (int j = 0; j < size[2]; j++) matrix_2(i, j) = (i + 3 * j) % 11 - 5;
+    }
+    S21Matrix classical(matrix_1);
+    S21Matrix strassen(matrix_1);
+    S21Matrix automatic(matrix_1);
+    classical.MulMatrix(matrix_2, s21::MulAlgorithm::kClassical);
+    strassen.MulMatrix(matrix_2, s21::MulAlgorithm::kStrassen);
+    automatic.MulMatrix(matrix_2);
+
+    ASSERT_EQ(size[2], strassen.GetCols());
+    ASSERT_TRUE(classical == strassen);
+    ASSERT_TRUE(classical == automatic);
+  }
+  s21::SetStrassenCrossover(crossover);
+}
+
+TEST(MatrixFile, SaveLoad) {
+  const char *path = "s21_matrix_test.bin";
+  S21Matrix matrix(3, 5);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 5; j++) matrix(i, j) = i * 0.1 - j * 7.5;
+  }
+  matrix.Save(path);
+  S21Matrix loaded = S21Matrix::Load(path);
+  ASSERT_EQ(3, loaded.GetRows());
+  ASSERT_EQ(5, loaded.GetCols());
+  ASSERT_FALSE(loaded.Mapped());
+  ASSERT_TRUE(loaded == matrix);
+
+  S21Matrix().Save(path);
+  ASSERT_EQ(0, S21Matrix::Load(path).GetRows());
+
+  matrix.Save(path);
+  std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+  file.seekp(4096 + 2 * sizeof(double));
+  file.put('\x7f');
+  file.close();
+  EXPECT_THROW(S21Matrix::Load(path), std::runtime_error);
+  file.open(path, std::ios::out | std::ios::trunc);
+  file << "1 2\n3 4\n";
+  file.close();
+  EXPECT_THROW(S21Matrix::Load(path), std::runtime_error);
+  EXPECT_THROW(S21Matrix::Map(path), std::runtime_error);
+  std::remove(path);
+  EXPECT_THROW(S21Matrix::Load(path), std::runtime_error);
+}
+
+TEST(MatrixFile, Map) {
+  const char *path = "s21_matrix_test.bin";
+  S21Matrix matrix(4, 9);
+  matrix.FillMatrix(2.5);
+  matrix.Save(path);
+  {
+    S21Matrix mapped = S21Matrix::Map(path);
+    ASSERT_TRUE(mapped.Mapped());
+    ASSERT_TRUE(mapped == matrix);
+    mapped(1, 1) = -1;
+    S21Matrix copy(mapped);
+    ASSERT_FALSE(copy.Mapped());
+    ASSERT_DOUBLE_EQ(-1, copy(1, 1));
+    mapped.TransposeInPlace();
+    ASSERT_FALSE(mapped.Mapped());
+    ASSERT_DOUBLE_EQ(2.5, mapped(8, 3));
+  }
+  ASSERT_TRUE(S21Matrix::Load(path) == matrix);
+  {
+    S21Matrix mapped = S21Matrix::Map(path, s21::MapMode::kShared);
+    mapped(3, 8) = 42;
+  }
+  S21Matrix loaded = S21Matrix::Load(path);
+  ASSERT_DOUBLE_EQ(42, loaded(3, 8));
+  ASSERT_DOUBLE_EQ(2.5, loaded(0, 0));
+  std::remove(path);
+}
+
+TEST(MatrixFile, ParseText) {
+  S21Matrix matrix =
+      S21Matrix::ParseText("\n  1, 2.5,-3\r\n\n+4;5e-1 6 \n 7\t8\t9e2,\n");
+  ASSERT_EQ(3, matrix.GetRows());
+  ASSERT_EQ(3, matrix.GetCols());
+  ASSERT_DOUBLE_EQ(2.5, matrix(0, 1));
+  ASSERT_DOUBLE_EQ(-3, matrix(0, 2));
+  ASSERT_DOUBLE_EQ(4, matrix(1, 0));
+  ASSERT_DOUBLE_EQ(0.5, matrix(1, 1));
+  ASSERT_DOUBLE_EQ(900, matrix(2, 2));
+  ASSERT_EQ(0, S21Matrix::ParseText(" \n\n").GetRows());
+  // The last line need not end in a newline.
+  S21Matrix unterminated = S21Matrix::ParseText("\n1 2\n\n3 4");
+  ASSERT_EQ(2, unterminated.GetRows());
+  ASSERT_DOUBLE_EQ(4, unterminated(1, 1));
+  ASSERT_EQ(1, S21Matrix::ParseText("\n \n5").GetRows());
+  EXPECT_THROW(S21Matrix::ParseText("1 2\n3\n"), std::runtime_error);
+  EXPECT_THROW(S21Matrix::ParseText("1 x\n"), std::runtime_error);
+  EXPECT_THROW(S21Matrix::ParseText("1,,2\n"), std::runtime_error);
+  EXPECT_THROW(S21Matrix::ParseText("1e999\n"), std::runtime_error);
+  EXPECT_THROW(S21Matrix::ParseText("+-3\n"), std::runtime_error);
+  EXPECT_THROW(S21Matrix::ParseText("1 ++3\n"), std::runtime_error);
+}
+
+TEST(MatrixFile, SaveLoadText) {
+  const char *path = "s21_matrix_test.txt";
+  S21Matrix matrix(3000, 37);
+  for (int i = 0; i < 3000; i++) {
+    for (int j = 0; j < 37; j++) matrix(i, j) = (i - 1500.0) / (j + 3) * 1e-3;
+  }
+  matrix(0, 0) = 1e-300;
+  matrix(1, 0) = -0.1;
+  matrix.SaveText(path, ',');
+  S21Matrix loaded = S21Matrix::LoadText(path);
+  ASSERT_EQ(3000, loaded.GetRows());
+  ASSERT_EQ(37, loaded.GetCols());
+  for (int i = 0; i < 3000; i++) {
+    for (int j = 0; j < 37; j++) ASSERT_EQ(matrix(i, j), loaded(i, j));
+  }
+  S21Matrix(2, 2).SaveText(path);
+  ASSERT_TRUE(S21Matrix::LoadText(path) == S21Matrix(2, 2));
+  S21Matrix corner = matrix.Block(0, 0, 3, 4);
+  corner.SaveText(path, '\t');
+  ASSERT_TRUE(S21Matrix::LoadText(path) == corner);
+  EXPECT_THROW(matrix.SaveText(path, '|'), std::invalid_argument);
+  ASSERT_EQ(3, S21Matrix::LoadText(path).GetRows());
+  std::remove(path);
+  EXPECT_THROW(S21Matrix::LoadText(path), std::runtime_error);
+}
+
+S21Matrix MakeSparseDense(int rows, int cols, int seed) {
+  S21Matrix matrix(rows, cols);
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) {
+      int hash = (i * 37 + j * 11 + seed) % 17;
+      if (hash < 3) matrix(i, j) = hash - 1 + 0.5 * (i - j);
+    }
+  }
+  return matrix;
+}
+
+TEST(SparseMatrix, Construct) {
+  S21Matrix dense(3, 4);
+  dense(0, 1) = 2;
+  dense(1, 3) = -0.001;
+  dense(2, 0) = 5;
+  dense(2, 3) = 1e-9;
+  S21SparseMatrix csr(dense, 1e-6);
+  S21SparseMatrix csc(dense, 0.0, s21::SparseFormat::kCsc);
+  ASSERT_EQ(3, csr.NonZeros());
+  ASSERT_EQ(4, csc.NonZeros());
+  ASSERT_DOUBLE_EQ(2, csr(0, 1));
+  ASSERT_DOUBLE_EQ(0, csr(2, 3));
+  ASSERT_DOUBLE_EQ(-0.001, csc(1, 3));
+  ASSERT_TRUE(csc.ToDense() == dense);
+  ASSERT_TRUE(csc.Convert(s21::SparseFormat::kCsr).ToDense() == dense);
+  EXPECT_THROW(csr(3, 0), std::range_error);
+
+  S21SparseMatrix triplets(2, 3, {{1, 2, 1.5}, {0, 0, 1}, {1, 2, 2}, {0, 1, 0}},
+                           s21::SparseFormat::kCsc);
+  ASSERT_EQ(2, triplets.NonZeros());
+  ASSERT_DOUBLE_EQ(3.5, triplets(1, 2));
+  EXPECT_THROW(S21SparseMatrix(2, 2, {{2, 0, 1}}), std::range_error);
+  EXPECT_THROW(S21SparseMatrix(0, 2), std::invalid_argument);
+  S21SparseMatrix empty(S21Matrix(), 0, s21::SparseFormat::kCsc);
+  ASSERT_EQ(s21::SparseFormat::kCsc, empty.GetFormat());
+  ASSERT_EQ(0, empty.NonZeros());
+}
+
+TEST(SparseMatrix, Arithmetics) {
+  const s21::SparseFormat formats[] = {s21::SparseFormat::kCsr,
+                                       s21::SparseFormat::kCsc};
+  for (s21::SparseFormat lhs_format : formats) {
+    for (s21::SparseFormat rhs_format : formats) {
+      S21Matrix a = MakeSparseDense(40, 30, 1), b = MakeSparseDense(40, 30, 5);
+      S21Matrix c = MakeSparseDense(30, 25, 9);
+      S21SparseMatrix sa(a, 0.0, lhs_format), sb(b, 0.0, rhs_format);
+      S21SparseMatrix sc(c, 0.0, rhs_format);
+
+      S21SparseMatrix sum(sa);
+      sum.SumMatrix(sb);
+      ASSERT_TRUE(sum.ToDense() == a + b);
+      sum.SubMatrix(sb);
+      ASSERT_TRUE(sum.ToDense() == a);
+      sum.SubMatrix(sa);
+      ASSERT_EQ(0, sum.NonZeros());
+      EXPECT_THROW(sum.SumMatrix(sc), std::logic_error);
+
+      S21Matrix product = a;
+      product.MulMatrix(c);
+      S21SparseMatrix sparse_product(sa);
+      sparse_product.MulMatrix(sc);
+      ASSERT_EQ(lhs_format, sparse_product.GetFormat());
+      ASSERT_TRUE(sparse_product.ToDense() == product);
+      ASSERT_TRUE(sa.MulDense(c) == product);
+      EXPECT_THROW(sc.MulMatrix(sa), std::logic_error);
+
+      ASSERT_TRUE(sa.Transpose().ToDense() == a.Transpose());
+      sa.MulNumber(-2);
+      ASSERT_TRUE(sa.ToDense() == a * -2.0);
+    }
+  }
+  // A product that underflows to zero is dropped like a cancelled sum.
+  for (s21::SparseFormat format :
+       {s21::SparseFormat::kCsr, s21::SparseFormat::kCsc}) {
+    S21SparseMatrix tiny(3, 2, {{0, 0, 1e-300}, {1, 1, 1}, {2, 0, -1e-300}},
+                         format);
+    tiny.MulNumber(1e-300);
+    ASSERT_EQ(1, tiny.NonZeros());
+    ASSERT_DOUBLE_EQ(1e-300, tiny(1, 1));
+    ASSERT_EQ(0.0, tiny(0, 0));
+    tiny.MulNumber(0);
+    ASSERT_EQ(0, tiny.NonZeros());
+  }
+}
+
+TEST(SparseMatrix, MulVector) {
+  S21Matrix dense = MakeSparseDense(300, 200, 3);
+  std::vector<double> vector(200);
+  for (int j = 0; j < 200; j++) vector[j] = j % 7 - 3;
+  S21SparseMatrix csr(dense), csc(dense, 0.0, s21::SparseFormat::kCsc);
+  std::vector<double> by_rows = csr.MulVector(vector);
+  std::vector<double> by_cols = csc.MulVector(vector);
+  for (int i = 0; i < 300; i++) {
+    double expected = 0;
+    for (int j = 0; j < 200; j++) expected += dense(i, j) * vector[j];
+    ASSERT_NEAR(expected, by_rows[i], 1e-9);
+    ASSERT_NEAR(expected, by_cols[i], 1e-9);
+  }
+  vector.pop_back();
+  EXPECT_THROW(csr.MulVector(vector), std::logic_error);
+}
+
+TEST(MatrixBatch, MulTranspose) {
+  S21MatrixBatch lhs(21, 3, 4), rhs(21, 4, 2);
+  for (int index = 0; index < 21; index++) {
+    for (int i = 0; i < 4; i++) {
+      for (int j = 0; j < 4; j++) {
+        if (i < 3) lhs(index, i, j) = index - i * 2 + j;
+        if (j < 2) rhs(index, i, j) = (index * i + j) % 5 - 2;
+      }
+    }
+  }
+  S21MatrixBatch transposed = lhs.Transpose();
+  ASSERT_EQ(4, transposed.GetRows());
+  ASSERT_TRUE(transposed.Get(7) == lhs.Get(7).Transpose());
+  S21MatrixBatch product(lhs);
+  product.MulMatrix(rhs);
+  ASSERT_EQ(2, product.GetCols());
+  for (int index = 0; index < 21; index++) {
+    S21Matrix expected = lhs.Get(index);
+    expected.MulMatrix(rhs.Get(index));
+    ASSERT_TRUE(product.Get(index) == expected);
+  }
+  EXPECT_THROW(rhs.MulMatrix(rhs), std::logic_error);
+  EXPECT_THROW(lhs(21, 0, 0), std::range_error);
+  EXPECT_THROW(S21MatrixBatch(0, 2, 2), std::invalid_argument);
+}
+
+TEST(MatrixBatch, DeterminantInverse) {
+  for (int n = 1; n <= 5; n++) {
+    S21MatrixBatch batch(13, n, n);
+    for (int index = 0; index < 13; index++) {
+      for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++)
+          batch(index, i, j) = (i == j ? n + 1.0 : 0.0) + (index + i * j) % 3;
+      }
+    }
+    std::vector<double> determinants = batch.Determinant();
+    S21MatrixBatch inverse = batch.InverseMatrix();
+    ASSERT_EQ(13u, determinants.size());
+    for (int index = 0; index < 13; index++) {
+      S21Matrix matrix = batch.Get(index);
+      ASSERT_NEAR(matrix.Determinant(), determinants[index], 1e-9);
+      ASSERT_TRUE(inverse.Get(index) == matrix.InverseMatrix());
+    }
+    for (int j = 0; j < n; j++) batch(12, 0, j) = 0;
+    EXPECT_THROW(batch.InverseMatrix(), std::logic_error);
+  }
+  // One lane singular up to rounding, the others small but regular.
+  S21MatrixBatch nearly_singular(11, 3, 3);
+  for (int index = 0; index < 11; index++) {
+    for (int i = 0; i < 3; i++) nearly_singular(index, i, i) = 1e-3;
+  }
+  ASSERT_DOUBLE_EQ(1e3, nearly_singular.InverseMatrix()(10, 1, 1));
+  for (int i = 0; i < 9; i++) nearly_singular(9, i / 3, i % 3) = 0.1 * (i + 1);
+  EXPECT_THROW(nearly_singular.Get(9).InverseMatrix(), std::logic_error);
+  EXPECT_THROW(nearly_singular.InverseMatrix(), std::logic_error);
+  EXPECT_THROW(S21MatrixBatch(4, 2, 3).Determinant(), std::length_error);
+}
+
+TEST(Arithmetics, GemmAxpy) {
+  const int sizes[][3] = {{3, 4, 5}, {70, 60, 50}};
+  for (const auto &size : sizes) {
+    S21Matrix a(size[0], size[1]), b(size[2], size[1]), c(size[0], size[2]);
+    for (int i = 0; i < size[0]; i++) {
+      for (int j = 0; j < size[1]; j++) a(i, j) = (i * 3 + j) % 7 - 3;
+      for (int j = 0; j < size[2]; j++) c(i, j) = (i + j) % 5;
+    }
+    for (int i = 0; i < size[2]; i++) {
+      for (int j = 0; j < size[1]; j++) b(i, j) = (i * j) % 4 - 1.5;
+    }
+    S21Matrix expected = a;
+    expected.MulMatrix(b.Transpose());
+    expected = expected * 2.0 - c * 0.5;
+
+    S21Matrix result = c;
+    result.Gemm(2.0, a, b.TransposedView(), -0.5);
+    ASSERT_TRUE(result == expected);
+    result.FillMatrix(NAN);
+    result.Gemm(2.0, a, b.TransposedView(), 0.0);
+    ASSERT_TRUE(result == expected + c * 0.5);
+    result = c;
+    result.Axpy(-3.0, expected);
+    ASSERT_TRUE(result == c - expected * 3.0);
+    result.Axpy(1.0, result);
+    ASSERT_TRUE(result == (c - expected * 3.0) * 2.0);
+    EXPECT_THROW(result.Gemm(1.0, a, b, 1.0), std::logic_error);
+    EXPECT_THROW(result.Axpy(1.0, a), std::logic_error);
+  }
+  S21Matrix square(60, 60), other(60, 60);
+  for (int i = 0; i < 60; i++) {
+    for (int j = 0; j < 60; j++) {
+      square(i, j) = (i + 2 * j) % 9 - 4;
+      other(i, j) = (3 * i + j) % 5 - 2;
+    }
+  }
+  S21Matrix expected = square;
+  expected.MulMatrix(other);
+  expected = expected + square;
+  S21Matrix result = square;
+  result.Gemm(1.0, result, other, 1.0);
+  ASSERT_TRUE(result == expected);
+  result = square;
+  result.Gemm(1.0, square, other, 1.0, s21::MulAlgorithm::kStrassen);
+  ASSERT_TRUE(result == expected);
+}
+
+S21Matrix MakeFilled(int rows, int cols, double value) {
+  S21Matrix matrix(rows, cols);
+  matrix.FillMatrix(value);
+  return matrix;
+}
+
+TEST(Arithmetics, AllocationsPerExpression) {
+  S21Matrix a = MakeFilled(5, 7, 1), b = MakeFilled(5, 7, 2);
+  S21Matrix c = MakeFilled(5, 7, 3), d = MakeFilled(5, 7, 4);
+  std::size_t before = s21::MatrixPool::Allocations();
+  S21Matrix sum = a + b + c + d;
+  ASSERT_EQ(1u, s21::MatrixPool::Allocations() - before);
+  ASSERT_TRUE(sum == MakeFilled(5, 7, 10));
+
+  before = s21::MatrixPool::Allocations();
+  sum = a - b + c * 2.0 - 0.5 * d;
+  sum = a;
+  ASSERT_EQ(&sum, &(sum += b));
+  ASSERT_EQ(&sum, &(sum -= c));
+  ASSERT_EQ(&sum, &(sum *= 4.0));
+  ASSERT_EQ(0u, s21::MatrixPool::Allocations() - before);
+  ASSERT_TRUE(sum == MakeFilled(5, 7, 0));
+
+  before = s21::MatrixPool::Allocations();
+  S21Matrix stolen = MakeFilled(5, 7, 1) + b - MakeFilled(5, 7, 3) * 2.0;
+  S21Matrix right = a - (b + MakeFilled(5, 7, 1));
+  S21Matrix both = MakeFilled(5, 7, 1) - MakeFilled(5, 7, 2);
+  ASSERT_EQ(5u, s21::MatrixPool::Allocations() - before);
+  ASSERT_TRUE(stolen == MakeFilled(5, 7, -3));
+  ASSERT_TRUE(right == MakeFilled(5, 7, -2));
+  ASSERT_TRUE(both == MakeFilled(5, 7, -1));
+  EXPECT_THROW(MakeFilled(2, 2, 0) + a, std::logic_error);
+}
+
+TEST(Precision, FloatArithmetics) {
+  S21MatrixF matrix_1(3, 3), matrix_2(3, 3);
+  float values[9] = {2, 5, 7, 6, 3, 4, 5, -2, -3};
+  for (int i = 0; i < 9; i++) {
+    matrix_1(i / 3, i % 3) = values[i];
+    matrix_2(i / 3, i % 3) = i;
+  }
+  S21MatrixF sum = matrix_1 + matrix_2 * 2.0;
+  ASSERT_FLOAT_EQ(11.0f, sum(0, 2));
+  ASSERT_FLOAT_EQ(-1.0f, matrix_1.Determinant());
+  S21MatrixF inverse = matrix_1.InverseMatrix();
+  ASSERT_NEAR(1.0f, inverse(0, 0), 1e-4);
+  ASSERT_NEAR(-38.0f, inverse(1, 0), 1e-3);
+  ASSERT_NEAR(-29.0f, inverse(2, 1), 1e-3);
+
+  // A float product agrees with the double one to single precision.
+  S21Matrix lhs(67, 130), rhs(130, 45);
+  for (int i = 0; i < 67; i++) {
+    for (int j = 0; j < 130; j++) lhs(i, j) = ((i * 7 + j * 3) % 11) - 5.0;
+  }
+  for (int i = 0; i < 130; i++) {
+    for (int j = 0; j < 45; j++) rhs(i, j) = ((i * 5 + j) % 13) * 0.25;
+  }
+  S21MatrixF product(lhs);
+  product.MulMatrix(S21MatrixF(rhs));
+  S21Matrix expected = lhs * rhs;
+  for (int i = 0; i < 67; i++) {
+    for (int j = 0; j < 45; j++)
+      ASSERT_NEAR(expected(i, j), product(i, j), 1e-3);
+  }
+  ASSERT_TRUE(S21MatrixF(expected) == product);
+  product(3, 3) += 1e-3f;
+  ASSERT_FALSE(S21MatrixF(expected) == product);
+}
+
+TEST(Precision, LongDouble) {
+  // The 6x6 Hilbert matrix has a condition number near 1.5e7: its inverse
+  // keeps about three more digits in long double than in double.
+  S21Matrix hilbert(6, 6);
+  S21MatrixLD hilbert_ld(6, 6);
+  for (int i = 0; i < 6; i++) {
+    for (int j = 0; j < 6; j++) {
+      hilbert(i, j) = 1.0 / (i + j + 1);
+      hilbert_ld(i, j) = 1.0L / (i + j + 1);
+    }
+  }
+  ASSERT_NEAR(1.0L / 186313420339200000.0L, hilbert_ld.Determinant(),
+              1e-30L);
+  const char *path = "s21_matrix_test.txt";
+  hilbert_ld.SaveText(path);
+  S21MatrixLD loaded = S21MatrixLD::LoadText(path);
+  std::remove(path);
+  for (int i = 0; i < 6; i++) {
+    for (int j = 0; j < 6; j++) ASSERT_EQ(hilbert_ld(i, j), loaded(i, j));
+  }
+
+  S21MatrixLD identity_ld = hilbert_ld * hilbert_ld.InverseMatrix();
+  S21Matrix identity = hilbert * hilbert.InverseMatrix();
+  long double error_ld = 0, error = 0;
+  for (int i = 0; i < 6; i++) {
+    for (int j = 0; j < 6; j++) {
+      long double target = i == j ? 1 : 0;
+      error_ld = std::max(error_ld, std::abs(identity_ld(i, j) - target));
+      error = std::max<long double>(error, std::abs(identity(i, j) - target));
+    }
+  }
+  ASSERT_LT(error_ld, 1e-8L);
+  ASSERT_LT(error_ld * 100, error);
+}
+
+TEST(Precision, Conversion) {
+  S21Matrix matrix(2, 3);
+  for (int i = 0; i < 2; i++) {
+    for (int j = 0; j < 3; j++) matrix(i, j) = 1.0 / (i + j + 3);
+  }
+  S21MatrixF narrow(matrix);
+  S21MatrixLD wide(narrow);
+  ASSERT_EQ(2, wide.GetRows());
+  ASSERT_EQ(3, wide.GetCols());
+  ASSERT_FLOAT_EQ(0.2f, narrow(1, 1));
+  ASSERT_EQ(static_cast<long double>(narrow(1, 1)), wide(1, 1));
+  ASSERT_TRUE(S21Matrix(narrow) == matrix);
+  ASSERT_EQ(0, S21MatrixF(S21Matrix()).GetRows());
+
+  // Files record their element type.
+  const char *path = "s21_matrix_test.bin";
+  narrow.Save(path);
+  S21MatrixF loaded = S21MatrixF::Load(path);
+  ASSERT_TRUE(loaded == narrow);
+  EXPECT_THROW(S21Matrix::Load(path), std::runtime_error);
+  EXPECT_THROW(S21MatrixLD::Map(path), std::runtime_error);
+  S21MatrixF mapped = S21MatrixF::Map(path);
+  ASSERT_TRUE(mapped.Mapped());
+  ASSERT_EQ(narrow(1, 2), mapped(1, 2));
+  std::remove(path);
+}
+
+TEST(Solve, MixedPrecision) {
+  const int n = 60;
+  S21Matrix a(n, n), expected(n, 2), b(n, 2);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) a(i, j) = 1.0 / (1 + std::abs(i - j));
+    a(i, i) += 4.0;
+    expected(i, 0) = i - n / 2;
+    expected(i, 1) = 1.0 / (i + 1);
+  }
+  b.Gemm(1.0, a, expected, 0.0);
+  s21::RefinementReport report;
+  S21Matrix x = s21::MixedSolve(a, b, &report);
+  ASSERT_TRUE(report.refined);
+  ASSERT_GT(report.iterations, 0);
+  ASSERT_LT(report.residual, 1e-15);
+  for (int i = 0; i < n; i++) {
+    ASSERT_NEAR(expected(i, 0), x(i, 0), 1e-12);
+    ASSERT_NEAR(expected(i, 1), x(i, 1), 1e-14);
+  }
+
+  S21Matrix inverse = s21::MixedInverse(a, &report);
+  ASSERT_TRUE(report.refined);
+  ASSERT_TRUE(inverse == a.InverseMatrix());
+
+  // Too ill-conditioned for float factors: solved in double instead.
+  S21Matrix hilbert(10, 10), ones(10, 1);
+  for (int i = 0; i < 10; i++) {
+    for (int j = 0; j < 10; j++) hilbert(i, j) = 1.0 / (i + j + 1);
+    ones(i, 0) = 1.0;
+  }
+  x = s21::MixedSolve(hilbert, ones, &report);
+  ASSERT_FALSE(report.refined);
+  ASSERT_LT(report.residual, 1e-15);
+
+  // Elements beyond the float range.
+  S21Matrix huge(2, 2), rhs(2, 1);
+  huge(0, 0) = huge(1, 1) = 1e300;
+  rhs(0, 0) = 2e300;
+  rhs(1, 0) = -1e300;
+  x = s21::MixedSolve(huge, rhs, &report);
+  ASSERT_FALSE(report.refined);
+  ASSERT_DOUBLE_EQ(2.0, x(0, 0));
+  ASSERT_DOUBLE_EQ(-1.0, x(1, 0));
+
+  ASSERT_EQ(0, s21::MixedInverse(S21Matrix()).GetRows());
+  S21Matrix singular(3, 3);
+  singular.FillMatrix(1.0);
+  EXPECT_THROW(s21::MixedInverse(singular), std::logic_error);
+  EXPECT_THROW(s21::MixedInverse(S21Matrix(2, 3)), std::length_error);
+  EXPECT_THROW(s21::MixedSolve(a, S21Matrix(3, 1)), std::logic_error);
+}
+
+TEST(Solve, LuFactorization) {
+  S21Matrix a(3, 3), b(3, 2);
+  double values[] = {2, -1, 0, -1, 2, -1, 0, -1, 2};
+  for (int i = 0; i < 9; i++) a(i / 3, i % 3) = values[i];
+  for (int i = 0; i < 3; i++) {
+    b(i, 0) = i + 1;
+    b(i, 1) = 1.0;
+  }
+  s21::LuFactorization lu(a);
+  ASSERT_EQ(3, lu.GetSize());
+  ASSERT_DOUBLE_EQ(4.0, lu.Determinant());
+  S21Matrix x = lu.Solve(b);
+  ASSERT_DOUBLE_EQ(2.5, x(0, 0));
+  ASSERT_DOUBLE_EQ(4.0, x(1, 0));
+  ASSERT_DOUBLE_EQ(3.5, x(2, 0));
+  ASSERT_DOUBLE_EQ(1.5, x(0, 1));
+  ASSERT_DOUBLE_EQ(2.0, x(1, 1));
+  ASSERT_TRUE(s21::Solve(a, b) == x);
+  ASSERT_TRUE(lu.Inverse() == a.InverseMatrix());
+
+  // Columns solved in place, through a strided view.
+  S21Matrix rows(3, 2);
+  rows(0, 0) = rows(1, 1) = 1.0;
+  rows(2, 0) = rows(2, 1) = 2.0;
+  S21Matrix swapped(2, 2);
+  swapped(0, 1) = swapped(1, 0) = 2.0;
+  s21::LuFactorization(swapped).SolveInPlace(rows.View().Transpose());
+  ASSERT_DOUBLE_EQ(0.0, rows(0, 0));
+  ASSERT_DOUBLE_EQ(0.5, rows(0, 1));
+  ASSERT_DOUBLE_EQ(0.5, rows(1, 0));
+  ASSERT_DOUBLE_EQ(1.0, rows(2, 1));
+
+  // Large enough for blocked substitution; every column and a single
+  // right-hand side give the same answer.
+  const int n = 300, rhs = 1000;
+  S21Matrix big(n, n), many(n, rhs);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) big(i, j) = ((i * 7 + j * 13) % 17) / 17.0;
+    big(i, i) += 1.0;
+    for (int j = 0; j < rhs; j++) many(i, j) = (i + j) % 5 - 2;
+  }
+  s21::LuFactorization big_lu(big);
+  S21Matrix solution = big_lu.Solve(many), check(n, rhs);
+  check.Gemm(1.0, big, solution, 0.0);
+  ASSERT_TRUE(check == many);
+  S21Matrix column(n, 1);
+  for (int i = 0; i < n; i++) column(i, 0) = many(i, rhs - 1);
+  column = big_lu.Solve(column);
+  for (int i = 0; i < n; i++)
+    ASSERT_NEAR(solution(i, rhs - 1), column(i, 0), 1e-9);
+
+  S21MatrixF narrow(a);
+  ASSERT_NEAR(3.5f, s21::Solve(narrow, S21MatrixF(b))(2, 0), 1e-5f);
+  ASSERT_EQ(0, s21::LuFactorization(S21Matrix()).GetSize());
+  ASSERT_EQ(0, s21::LuFactorization(S21Matrix()).Inverse().GetRows());
+  ASSERT_EQ(0, s21::CholeskyFactorization(S21Matrix()).Inverse().GetRows());
+  S21Matrix singular(3, 3);
+  singular.FillMatrix(1.0);
+  EXPECT_THROW(s21::LuFactorization{singular}, std::logic_error);
+  EXPECT_THROW(s21::Solve(S21Matrix(2, 3), b), std::length_error);
+  EXPECT_THROW(lu.Solve(S21Matrix(2, 1)), std::logic_error);
+}
+
+TEST(Solve, Cholesky) {
+  using s21::Factorization;
+  // A covariance-like matrix: X^T X plus a ridge.
+  const int n = 200;
+  S21Matrix x(n, n), a(n, n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) x(i, j) = ((i * 7 + j * 13) % 17) / 17.0 - 0.5;
+  }
+  a.Gemm(1.0, x.View().Transpose(), x, 0.0);
+  for (int i = 0; i < n; i++) a(i, i) += 1.0;
+  double log_determinant = a.LogDeterminant(Factorization::kLu);
+  ASSERT_NEAR(log_determinant, a.LogDeterminant(), 1e-9);
+  ASSERT_NEAR(std::exp(log_determinant), a.Determinant(),
+              1e-9 * a.Determinant());
+  ASSERT_TRUE(a.InverseMatrix() == a.InverseMatrix(Factorization::kLu));
+  ASSERT_TRUE(a.InverseMatrix(Factorization::kCholesky) == a.InverseMatrix());
+
+  s21::CholeskyFactorization cholesky(a);
+  s21::LuFactorization lu(a);
+  ASSERT_EQ(n, cholesky.GetSize());
+  ASSERT_NEAR(log_determinant, cholesky.LogDeterminant(), 1e-9);
+  ASSERT_NEAR(log_determinant, lu.LogDeterminant(), 1e-9);
+  ASSERT_TRUE(cholesky.Inverse() == lu.Inverse());
+  S21Matrix b(n, 3), wide(n, 1500);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < 3; j++) b(i, j) = i - j * n / 2;
+    for (int j = 0; j < 1500; j++) wide(i, j) = (i * j) % 7 - 3;
+  }
+  ASSERT_TRUE(cholesky.Solve(b) == lu.Solve(b));
+  ASSERT_TRUE(s21::Solve(a, b) == lu.Solve(b));
+  S21Matrix column = b.View().ColView(2);
+  ASSERT_TRUE(cholesky.Solve(column) == lu.Solve(column));
+  S21Matrix check(n, 1500);
+  check.Gemm(1.0, a, cholesky.Solve(wide), 0.0);
+  ASSERT_TRUE(check == wide);
+
+  // The determinant overflows, its logarithm does not.
+  S21Matrix huge(300, 300);
+  for (int i = 0; i < 300; i++) {
+    huge(i, i) = 1e3;
+    if (i) huge(i, i - 1) = huge(i - 1, i) = 1.0;
+  }
+  ASSERT_TRUE(std::isinf(huge.Determinant()));
+  ASSERT_NEAR(300 * std::log(1e3), huge.LogDeterminant(), 1e-2);
+  ASSERT_NEAR(huge.LogDeterminant(Factorization::kLu), huge.LogDeterminant(),
+              1e-9);
+
+  // Symmetric but indefinite: automatic detection falls back to LU, the
+  // hint refuses.
+  S21Matrix indefinite(4, 4);
+  double values[] = {1, 2, 0, 0, 2, 1, 0, 0, 0, 0, 3, 1, 0, 0, 1, 3};
+  for (int i = 0; i < 16; i++) indefinite(i / 4, i % 4) = values[i];
+  ASSERT_DOUBLE_EQ(-24.0, indefinite.Determinant());
+  ASSERT_NEAR(std::log(24.0), indefinite.LogDeterminant(), 1e-12);
+  ASSERT_TRUE(indefinite.InverseMatrix() ==
+              indefinite.InverseMatrix(Factorization::kLu));
+  EXPECT_THROW(indefinite.Determinant(Factorization::kCholesky),
+               std::logic_error);
+  EXPECT_THROW(indefinite.InverseMatrix(Factorization::kCholesky),
+               std::logic_error);
+  EXPECT_THROW(s21::CholeskyFactorization{indefinite}, std::logic_error);
+  EXPECT_THROW(
+      s21::Solve(indefinite, S21Matrix(4, 1), Factorization::kCholesky),
+      std::logic_error);
+  ASSERT_DOUBLE_EQ(-24.0, s21::LuFactorization(indefinite).Determinant());
+
+  // Small SPD matrices go straight to LU, in Solve as in InverseMatrix.
+  S21Matrix small = a.Block(0, 0, 4, 4), small_b = b.Block(0, 0, 4, 3);
+  S21Matrix small_x = s21::Solve(small, small_b);
+  S21Matrix small_lu = s21::LuFactorization(small).Solve(small_b);
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 3; j++) ASSERT_EQ(small_lu(i, j), small_x(i, j));
+  }
+
+  S21Matrix singular(4, 4);
+  singular.FillMatrix(1.0);
+  ASSERT_EQ(0.0, singular.Determinant());
+  ASSERT_TRUE(std::isinf(singular.LogDeterminant()));
+  S21MatrixF narrow(a);
+  ASSERT_NEAR(log_determinant, narrow.LogDeterminant(), 1e-2);
+  EXPECT_THROW(S21Matrix(2, 3).LogDeterminant(), std::length_error);
+}
+
+TEST(Solve, LeastSquares) {
+  // Tall enough for several panels, with a trailing partial one.
+  const int m = 150, n = 70;
+  S21Matrix a(m, n), x(n, 2);
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < n; j++) a(i, j) = ((i * 11 + j * 5) % 23) / 23.0 - 0.5;
+    if (i < n) a(i, i) += 2.0;
+  }
+  for (int i = 0; i < n; i++) {
+    x(i, 0) = i % 5 - 2;
+    x(i, 1) = 0.5 * i;
+  }
+  // A consistent system is solved exactly.
+  S21Matrix b(m, 2);
+  b.Gemm(1.0, a, x, 0.0);
+  s21::QrFactorization qr(a);
+  ASSERT_EQ(m, qr.GetRows());
+  ASSERT_EQ(n, qr.GetCols());
+  ASSERT_TRUE(qr.Solve(b) == x);
+  ASSERT_TRUE(s21::Solve(a, b) == x);
+
+  // Otherwise the residual is orthogonal to the columns of A.
+  for (int i = 0; i < m; i++) b(i, 1) += (i * 3) % 7 - 3;
+  S21Matrix residual = b;
+  residual.Gemm(-1.0, a, qr.Solve(b), 1.0);
+  S21Matrix normal(n, 2);
+  normal.Gemm(1.0, a.View().Transpose(), residual, 0.0);
+  ASSERT_TRUE(normal == S21Matrix(n, 2));
+
+  S21Matrix q = qr.FormQ(), r = qr.GetR();
+  ASSERT_EQ(m, q.GetRows());
+  ASSERT_EQ(n, q.GetCols());
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < i; j++) ASSERT_EQ(0.0, r(i, j));
+  }
+  S21Matrix product(m, n), identity(n, n);
+  product.Gemm(1.0, q, r, 0.0);
+  ASSERT_TRUE(product == a);
+  identity.Gemm(1.0, q.View().Transpose(), q, 0.0);
+  for (int i = 0; i < n; i++) identity(i, i) -= 1.0;
+  ASSERT_TRUE(identity == S21Matrix(n, n));
+
+  // Q is applied in place, through strided views too.
+  S21Matrix c(3, m), original(3, m);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < m; j++) c(i, j) = original(i, j) = (i + 2 * j) % 9;
+  }
+  qr.MultiplyQTranspose(c.TransposedView());
+  ASSERT_FALSE(c == original);
+  qr.MultiplyQ(c.TransposedView());
+  ASSERT_TRUE(c == original);
+
+  S21Matrix deficient(6, 3);
+  for (int i = 0; i < 6; i++) {
+    deficient(i, 0) = i;
+    deficient(i, 1) = 1.0;
+    deficient(i, 2) = 2.0 * i - 3.0;
+  }
+  EXPECT_THROW(s21::QrFactorization(deficient).Solve(S21Matrix(6, 1)),
+               std::logic_error);
+  EXPECT_THROW(qr.Solve(S21Matrix(n, 1)), std::logic_error);
+  EXPECT_THROW(s21::QrFactorization{S21Matrix(2, 3)}, std::length_error);
+
+  S21MatrixF narrow(a), narrow_b(m, 1);
+  for (int i = 0; i < m; i++) narrow_b(i, 0) = static_cast<float>(b(i, 0));
+  S21MatrixF narrow_x =
+      s21::BasicQrFactorization<float>(narrow).Solve(narrow_b);
+  for (int i = 0; i < n; i++) ASSERT_NEAR(x(i, 0), narrow_x(i, 0), 1e-3);
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();